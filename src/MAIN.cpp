@@ -8,7 +8,7 @@
 std::vector<std::string> valid() {
 
     // Return a list of valid outputs
-    return {"time", "popsize", "patchsizes", "traitmeans", "individuals"};
+    return {"time", "popsize", "patchsizes", "traitmeans", "individuals", "genomes", "genomebytes"};
 
 }
 
@@ -25,7 +25,7 @@ void doMain(const std::vector<std::string> &args) {
     const std::string parfile = args.size() == 2u ? args[1u] : "";
 
     // Create parameters (from file if needed)
-    const Parameters pars(parfile);
+    Parameters pars(parfile);
 
     // Verbose
     if (args.size() == 2u) std::cout << "Parameters read in succesfully\n";
@@ -46,6 +46,21 @@ void doMain(const std::vector<std::string> &args) {
     pars.check();
     arch.check();
 
+    // Prepare to record the time taken by each mutation sampler
+    std::vector<double> timings;
+
+    // If needed...
+    if (pars.sampler == Mutator::AUTO) {
+
+        // Pick the fastest mutation sampler
+        pars.sampler = Mutator::tune(pars.mutation, arch, timings, pars.engine);
+
+        // Say which one (and how long each took)
+        std::cout << "Mutation sampler " << pars.sampler << " picked at startup\n";
+        Mutator::report(std::cout, timings);
+
+    }
+
     // Verbose
     if (pars.loadarch) std::cout << "Genetic architecture read in succesfully\n";
 
@@ -55,6 +70,9 @@ void doMain(const std::vector<std::string> &args) {
     // Save parameters if necessary
     if (pars.savepars) pars.save("paramlog.txt");
 
+    // Record how the mutation sampler was picked if needed
+    if (pars.savepars && !timings.empty()) Mutator::report("paramlog.txt", timings);
+
     // Create a printer
     Printer print(valid(), pars.memsave);
 
@@ -5,9 +5,12 @@
 // Constructor
 Architecture::Architecture(const Parameters &pars, const std::string &filename) :
     nloci(pars.nloci),
+    nwords((nloci + 63u) / 64u),
     tolmax(pars.effect * pars.nloci),
+    uniform(true),
     locations(std::vector<double>(nloci, 0.0)),
-    effects(std::vector<double>(nloci, pars.effect))
+    effects(std::vector<double>(nloci, pars.effect)),
+    table(std::vector<size_t>())
 {
 
     // pars: architecture parameters
@@ -26,7 +29,8 @@ void Architecture::check() const {
 
     // Check
     assert(nloci != 0u);
-    assert(nloci <= 1000u);
+    assert(nloci <= 100000u);
+    assert(nwords == (nloci + 63u) / 64u);
     assert(locations.size() == nloci);
     assert(effects.size() == nloci);
     assert(locations[0u] >= 0.0);
@@ -36,30 +40,101 @@ void Architecture::check() const {
     assert(!effects.empty());
     assert(tolmax > 0.0);
     for (auto x : effects) assert(x > 0.0);
+    assert(table.size() == nloci + 1u);
 
 }
 
 // Function to generate a new architecture
 void Architecture::make() {
 
-    // Prepare a location sampler
-    auto getLocation = rnd::uniform(0.0, 1.0);
-
     // Sample locus locations
     for (size_t l = 0u; l < nloci; ++l)
-        locations[l] = getLocation(rnd::rng);
+        locations[l] = rnd::unit(rnd::rng);
 
     // Now sort the vector of locations
     std::sort(locations.begin(), locations.end());
+
+    // Prepare to look up locations
+    tabulate();
     
     // Compute maximum trait value
     for (double &effect : effects) tolmax += effect;
 
+    // Are effect sizes all the same?
+    uniform = std::adjacent_find(effects.begin(), effects.end(), std::not_equal_to<double>()) == effects.end();
+
     // Check
     check();
 
 }
 
+// Function to prepare the lookup table of locus locations
+void Architecture::tabulate() {
+
+    // Note: the genome is cut into as many bins of equal length as there are
+    // loci, and for each bin we record the index of the first locus lying
+    // beyond the start of that bin. Finding the loci around any position
+    // then takes a table lookup and, on average, about one comparison.
+
+    // Number of bins
+    const size_t nbins = nloci;
+
+    // Prepare the table
+    table.assign(nbins + 1u, 0u);
+
+    // Current locus
+    size_t l = 0u;
+
+    // For each bin...
+    for (size_t b = 0u; b <= nbins; ++b) {
+
+        // Start of the bin
+        const double start = static_cast<double>(b) / nbins;
+
+        // Skip loci lying at or before that point
+        while (l < locations.size() && locations[l] <= start) ++l;
+
+        // Record
+        table[b] = l;
+
+    }
+}
+
+// Function to find how many loci lie at or before a position
+size_t Architecture::locate(const double &x) const {
+
+    // x: position along the genome
+
+    // Check
+    assert(table.size() == nloci + 1u);
+
+    // Beyond the end of the genome
+    if (x >= 1.0) return nloci;
+
+    // Before the start of the genome
+    if (x < 0.0) return 0u;
+
+    // Bin of the position
+    const size_t b = std::min(static_cast<size_t>(x * nloci), nloci - 1u);
+
+    // Start from the first locus beyond the start of the bin
+    size_t l = table[b];
+
+    // Move past loci lying at or before the position
+    while (l < nloci && locations[l] <= x) ++l;
+
+    // Step back in case rounding put the position in the next bin
+    while (l > 0u && locations[l - 1u] > x) --l;
+
+    // Check
+    assert(l == nloci || locations[l] > x);
+    assert(l == 0u || locations[l - 1u] <= x);
+
+    // Exit
+    return l;
+
+}
+
 // Function to load the genetic architecture from a file
 void Architecture::read(const std::string &filename) {
 
@@ -91,7 +166,7 @@ void Architecture::read(const std::string &filename) {
         std::string name = reader.getname();
 
         // Read the parameter value(s)
-        if (name == "nloci") reader.readvalue<size_t>(nloci, chk::onetothousand<size_t>);
+        if (name == "nloci") reader.readvalue<size_t>(nloci, chk::onetohundredthousand<size_t>);
         else if (name == "locations") reader.readvalues<double>(locations, nloci, chk::proportion<double>, chk::strictorder<double>);
         else if (name == "effects") reader.readvalues<double>(effects, nloci, chk::strictpos<double>);
         else 
@@ -108,12 +183,21 @@ void Architecture::read(const std::string &filename) {
     // Close the file
     reader.close();
 
+    // Update the genome width
+    nwords = (nloci + 63u) / 64u;
+
+    // Update the lookup table
+    tabulate();
+
     // Reset
     tolmax = 0.0;
 
     // Update
     for (double &effect : effects) tolmax += effect;
 
+    // Are effect sizes all the same?
+    uniform = std::adjacent_find(effects.begin(), effects.end(), std::not_equal_to<double>()) == effects.end();
+
     // Check
     check();
 
@@ -135,14 +219,33 @@ void Architecture::save(const std::string &filename) const
     // Write the number of loci
     file << "nloci " << nloci << '\n';
     
+    // Note: values are written with as many digits as needed to be read back
+    // exactly, so that nearby loci of a large architecture stay distinct.
+
+    // Function to write a value
+    auto write = [&file](const double &x) {
+
+        // Format the value
+        std::array<char, 32u> buffer;
+        const auto [ptr, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), x);
+
+        // Check
+        assert(ec == std::errc());
+
+        // Write it
+        file << ' ';
+        file.write(buffer.data(), ptr - buffer.data());
+
+    };
+
     // Write the locations of loci
     file << "locations";
-    for (size_t l = 0u; l < nloci; ++l) file << ' ' << locations[l];
+    for (size_t l = 0u; l < nloci; ++l) write(locations[l]);
     file << '\n';
 
     // Write the effect sizes
     file << "effects";
-    for (size_t l = 0u; l < nloci; ++l) file << ' ' << effects[l];
+    for (size_t l = 0u; l < nloci; ++l) write(effects[l]);
     file << '\n';
 
     // Close the file
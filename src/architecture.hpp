@@ -10,6 +10,11 @@
 
 #include "parameters.hpp"
 #include "random.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <charconv>
+#include <array>
  
 struct Architecture {
 
@@ -21,15 +26,24 @@ struct Architecture {
     void make();
     void read(const std::string&);
     void save(const std::string&) const;
+    void tabulate();
+
+    // Function to find how many loci lie at or before a position
+    size_t locate(const double&) const;
 
     // Hyperparameters
     size_t nloci;
+    size_t nwords; // number of 64-bit words needed to store a genome
     double tolmax;
+    bool uniform;  // whether all loci have the same effect size
     
     // Parameters
     std::vector<double> locations; // gene locations
     std::vector<double> effects;   // effect sizes
 
+    // Lookup table
+    std::vector<size_t> table;     // first locus lying beyond the start of each bin
+
 };
 
 #endif
\ No newline at end of file
@@ -16,11 +16,27 @@ namespace chk {
 
     }
 
-    // Function to check that a value is between 1 and 1000
+    // Function to check that a value is between 1 and 100000
     template <typename T>
-    std::string onetothousand(const T &x) {
+    std::string onetohundredthousand(const T &x) {
 
-        return x <= 0u || x > 1000u ? "must be between 1 and 1000" : "";
+        return x <= 0u || x > 100000u ? "must be between 1 and 100000" : "";
+
+    }
+
+    // Function to check that a value identifies a random number engine
+    template <typename T>
+    std::string engine(const T &x) {
+
+        return x > 2u ? "must be 0, 1 or 2" : "";
+
+    }
+
+    // Function to check that a value identifies a mutation sampler
+    template <typename T>
+    std::string sampler(const T &x) {
+
+        return x > 4u ? "must be 0, 1, 2, 3 or 4" : "";
 
     }
 
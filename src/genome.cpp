@@ -0,0 +1,757 @@
+// This script contains the functions of the gen namespace.
+
+#include "genome.hpp"
+
+// Function to tell whether a bit is set
+bool gen::test(const word *alleles, const size_t &i) {
+
+    // alleles: words of the genome
+    // i: index of the locus
+
+    // Check
+    assert(i < NWORDS * WORDBITS);
+
+    // Read the bit
+    return (alleles[i / WORDBITS] >> (i % WORDBITS)) & 1u;
+
+}
+
+// Function to toggle a bit
+void gen::toggle(word *alleles, const size_t &i) {
+
+    // alleles: words of the genome
+    // i: index of the locus
+
+    // Check
+    assert(i < NWORDS * WORDBITS);
+
+    // Toggle the bit
+    alleles[i / WORDBITS] ^= word(1u) << (i % WORDBITS);
+
+}
+
+// Function to set a range of bits
+void gen::fill(word *mask, const size_t &from, const size_t &to) {
+
+    // mask: words to set bits in
+    // from: first bit to set
+    // to: bit after the last bit to set
+
+    // Check
+    assert(from <= to);
+    assert(to <= NWORDS * WORDBITS);
+
+    // Nothing to do if the range is empty
+    if (from == to) return;
+
+    // Words containing the first and last bits
+    const size_t first = from / WORDBITS;
+    const size_t last = (to - 1u) / WORDBITS;
+
+    // All ones
+    const word ones = ~word(0u);
+
+    // Bits from the start of the range within the first word
+    const word head = ones << (from % WORDBITS);
+
+    // Bits up to the end of the range within the last word
+    const word tail = ones >> (WORDBITS - 1u - (to - 1u) % WORDBITS);
+
+    // If the range fits within a single word...
+    if (first == last) {
+
+        // Set the bits in between
+        mask[first] |= head & tail;
+
+        // Exit
+        return;
+
+    }
+
+    // Otherwise set the ends
+    mask[first] |= head;
+    mask[last] |= tail;
+
+    // And every word in between
+    for (size_t w = first + 1u; w < last; ++w) mask[w] = ones;
+
+}
+
+// Function to count the number of bits set
+size_t gen::count(const word *alleles, const size_t &nwords) {
+
+    // alleles: words of the genome
+    // nwords: number of words in the genome
+
+    // Check
+    assert(nwords <= NWORDS);
+
+    // Prepare to count
+    size_t n = 0u;
+
+    // Count bits set in each word
+    for (size_t w = 0u; w < nwords; ++w) n += std::popcount(alleles[w]);
+
+    // Exit
+    return n;
+
+}
+
+// Function to borrow scratch space for a genome
+gen::word* gen::scratch(const size_t &use, const size_t &nwords) {
+
+    // use: what the space is for (see gen::SEED etc.)
+    // nwords: number of words needed
+
+    // Note: each thread has its own scratch genomes, which only ever grow, so
+    // they are allocated once per thread and sized to the genomes actually
+    // simulated. The space is left as it was by its last use.
+
+    // Check
+    assert(use < NSCRATCH);
+    assert(nwords <= NWORDS);
+
+    // Scratch genomes of the current thread
+    static thread_local std::array<std::vector<word>, NSCRATCH> genomes;
+
+    // Make room if needed
+    if (genomes[use].size() < nwords) genomes[use].resize(nwords);
+
+    // Exit
+    return genomes[use].data();
+
+}
+
+// Function to append the positions of the loci carrying allele 1 to a list
+void gen::encode(const word *alleles, const size_t &nwords, std::vector<std::uint16_t> &positions) {
+
+    // alleles: words of the genome
+    // nwords: number of words in the genome
+    // positions: list to append to
+
+    // Check
+    assert(nwords <= NWORDS);
+    assert(nwords * WORDBITS <= UINT16_MAX + 1u);
+
+    // For each word...
+    for (size_t w = 0u; w < nwords; ++w) {
+
+        // For each bit set, lowest first...
+        for (word x = alleles[w]; x; x &= x - 1u) {
+
+            // Record its position
+            positions.push_back(w * WORDBITS + std::countr_zero(x));
+
+        }
+    }
+}
+
+// Function to rebuild a genome from the positions of the loci carrying allele 1
+void gen::decode(const std::uint16_t *positions, const size_t &n, word *alleles, const size_t &nwords) {
+
+    // positions: list of positions
+    // n: number of positions
+    // alleles: words of the genome to rebuild
+    // nwords: number of words in the genome
+
+    // Check
+    assert(nwords <= NWORDS);
+
+    // Start from an empty genome
+    std::fill_n(alleles, nwords, word(0u));
+
+    // Set the bits listed
+    for (size_t j = 0u; j < n; ++j) {
+
+        // Check
+        assert(positions[j] < nwords * WORDBITS);
+
+        // Set
+        alleles[positions[j] / WORDBITS] |= word(1u) << (positions[j] % WORDBITS);
+
+    }
+}
+
+// Function to compute the trait value of a whole genome
+double gen::evaluate(const word *alleles, const Architecture &arch) {
+
+    // alleles: words of the genome
+    // arch: genetic architecture
+
+    // Note: the trait value is the sum of the effects of the loci carrying
+    // allele 1 (a genome with only zeros has a trait value of zero).
+
+    // With equal effects, count the loci carrying allele 1
+    if (arch.uniform) return count(alleles, arch.nwords) * arch.effects[0u];
+
+    // Otherwise sum their effects
+    return krn::dot(alleles, arch.effects.data(), arch.nloci);
+
+}
+
+// Function to update the trait value after alleles 1 have been gained or lost
+double gen::recount(const double &tolerance, const std::ptrdiff_t &gained, const Architecture &arch) {
+
+    // tolerance: current trait value
+    // gained: number of alleles 1 gained (negative if lost)
+    // arch: genetic architecture
+
+    // Note: with equal effects the trait value is the number of alleles 1
+    // times the effect, so the count can be recovered from it and updated,
+    // giving the same value as evaluating the whole genome again.
+
+    // Check
+    assert(arch.uniform);
+    assert(arch.effects[0u] > 0.0);
+
+    // Number of alleles 1 before the change
+    const std::ptrdiff_t n = std::llround(tolerance / arch.effects[0u]);
+
+    // Check
+    assert(n + gained >= 0);
+    assert(n + gained <= static_cast<std::ptrdiff_t>(arch.nloci));
+
+    // Exit
+    return static_cast<size_t>(n + gained) * arch.effects[0u];
+
+}
+
+// Function to compute the trait value carried by a single word of a genome
+static double wordvalue(const gen::word *alleles, const size_t &w, const Architecture &arch) {
+
+    // alleles: words of the genome
+    // w: index of the word
+    // arch: genetic architecture
+
+    // Number of loci in the word
+    const size_t n = std::min(gen::WORDBITS, arch.nloci - w * gen::WORDBITS);
+
+    // Sum the effects of the loci carrying allele 1
+    return krn::dot(alleles + w, arch.effects.data() + w * gen::WORDBITS, n);
+
+}
+
+// Function to compute the trait value of a genome, leaving out fixed loci
+double gen::evaluate(const word *alleles, const Architecture &arch, const Diversity *diversity) {
+
+    // alleles: words of the genome
+    // arch: genetic architecture
+    // diversity: survey of the loci that vary (if any)
+
+    // Note: the genome must carry the same alleles as the genomes surveyed
+    // at fixed loci, except where it has mutated since. Words with fixed loci
+    // only contribute the offset, unless they have mutated, in which case the
+    // difference is added. The result may differ from a full evaluation in the
+    // last digits, as effects are not summed in the same order.
+
+    // Evaluate the whole genome if there is no survey, or if counting is enough
+    if (!diversity || arch.uniform) return evaluate(alleles, arch);
+
+    // Check
+    assert(diversity->nwords == arch.nwords);
+
+    // Start from the trait value carried by fixed loci
+    double x = diversity->offset;
+
+    // Add that of the words with loci that vary
+    for (size_t w : diversity->words) x += wordvalue(alleles, w, arch);
+
+    // Correct for fixed words that have mutated since
+    for (size_t w = 0u; w < arch.nwords; ++w)
+        if (!diversity->active(w) && alleles[w] != diversity->all[w]) x += wordvalue(alleles, w, arch) - diversity->sums[w];
+
+    // Exit
+    return x;
+
+}
+
+// Constructor
+gen::Diversity::Diversity(const size_t &n) :
+    nwords(n),
+    all(std::vector<word>(n, ~word(0u))),
+    any(std::vector<word>(n, word(0u))),
+    words(std::vector<size_t>()),
+    sums(std::vector<double>(n, 0.0)),
+    offset(0.0)
+{
+
+    // n: number of words per genome
+
+    // Check
+    assert(nwords <= NWORDS);
+
+    // Start empty
+    reset();
+
+}
+
+// Function to start a new survey
+void gen::Diversity::reset() {
+
+    // Every locus is fixed until genomes say otherwise
+    std::fill_n(all.begin(), nwords, ~word(0u));
+    std::fill_n(any.begin(), nwords, word(0u));
+
+}
+
+// Function to add a genome to the survey
+void gen::Diversity::add(const word *alleles) {
+
+    // alleles: words of the genome
+
+    // Fold it into the reductions
+    for (size_t w = 0u; w < nwords; ++w) {
+
+        all[w] &= alleles[w];
+        any[w] |= alleles[w];
+
+    }
+}
+
+// Function to summarize the survey once all genomes have been added
+void gen::Diversity::close(const Architecture &arch) {
+
+    // arch: genetic architecture
+
+    // Check
+    assert(arch.nwords == nwords);
+
+    // Reset
+    words.clear();
+    offset = 0.0;
+
+    // For each word...
+    for (size_t w = 0u; w < nwords; ++w) {
+
+        // Record it if some of its loci vary
+        if (active(w)) { words.push_back(w); continue; }
+
+        // Otherwise record the trait value carried by its fixed loci
+        sums[w] = wordvalue(all.data(), w, arch);
+        offset += sums[w];
+
+    }
+}
+
+// Function to return the number of loci that vary
+size_t gen::Diversity::polymorphic() const {
+
+    // Prepare to count
+    size_t n = 0u;
+
+    // Count the loci that differ between reductions
+    for (size_t w = 0u; w < nwords; ++w) n += std::popcount(any[w] ^ all[w]);
+
+    // Exit
+    return n;
+
+}
+
+// Function to update trait value when an allele has just flipped
+void gen::flip(word *alleles, double &tolerance, const size_t &i, const Architecture &arch) {
+
+    // alleles: words of the genome
+    // tolerance: trait value to update
+    // i: index of the allele to flip
+    // arch: genetic architecture
+
+    // Check
+    assert(i < arch.nloci);
+
+    // Flip the allele
+    toggle(alleles, i);
+
+    // Update trait value
+    tolerance += arch.effects[i] * (test(alleles, i) * 2.0 - 1.0);
+
+    // Note: this translates the new allele into plus or minus one.
+
+}
+
+// Function to mutate all loci
+void gen::flipall(word *alleles, double &tolerance, const Architecture &arch) {
+
+    // Flip every locus of the words in use
+    for (size_t w = 0u; w < arch.nwords; ++w) alleles[w] = ~alleles[w];
+
+    // Leave the unused bits of the last word at zero
+    if (arch.nloci % WORDBITS) alleles[arch.nwords - 1u] &= ~word(0u) >> (WORDBITS - arch.nloci % WORDBITS);
+
+    // Update trait value
+    tolerance = evaluate(alleles, arch);
+
+}
+
+// Function to mutate using Bernoulli sampling
+void gen::mutateBernoulli(
+    word *alleles, double &tolerance, const double &mu,
+    const Architecture &arch, rnd::generator &rng
+) {
+
+    // Prepare a mutation sampler
+    auto isMutation = rnd::Bernoulli(mu);
+
+    // For each word of the genome...
+    for (size_t w = 0u; w < arch.nwords; ++w) {
+
+        // Number of loci in this word
+        const size_t n = std::min(WORDBITS, arch.nloci - w * WORDBITS);
+
+        // Sample which of them mutate and flip them, all in one go
+        alleles[w] ^= isMutation.mask(rng, n);
+
+    }
+
+    // Update trait value
+    tolerance = evaluate(alleles, arch);
+
+}
+
+// Function to sample a number of mutations and shuffle them around
+void gen::mutateShuffle(
+    word *alleles, double &tolerance, const double &mu,
+    const Architecture &arch, rnd::generator &rng
+) {
+
+    // Sample the number of mutations
+    const size_t n = rnd::Binomial(arch.nloci, mu)(rng);
+
+    // Check
+    assert(n <= arch.nloci);
+
+    // Exit if zero
+    if (n == 0u) return;
+
+    // If needed...
+    if (n == arch.nloci) {
+
+        // Mutate all loci
+        flipall(alleles, tolerance, arch);
+
+        // Exit
+        return;
+
+    }
+
+    // Prepare to record mutated loci
+    word *mutated = scratch(MARKS, arch.nwords);
+
+    // Only clear the words in use
+    std::fill_n(mutated, arch.nwords, word(0u));
+
+    // Note: this is Floyd's algorithm, which picks n distinct loci with exactly
+    // n draws, without having to store and shuffle a list of all the loci.
+
+    // For each of the last n loci...
+    for (size_t j = arch.nloci - n; j < arch.nloci; ++j) {
+
+        // Sample a locus up to that one
+        size_t i = rnd::Random(0u, j)(rng);
+
+        // Take that one instead if the sampled locus has already been hit
+        if (test(mutated, i)) i = j;
+
+        // Record
+        toggle(mutated, i);
+
+    }
+
+    // Flip the mutated loci
+    for (size_t w = 0u; w < arch.nwords; ++w) alleles[w] ^= mutated[w];
+
+    // Update trait value
+    tolerance = evaluate(alleles, arch);
+
+}
+
+// Function to mutate using geometric sampling
+void gen::mutateGeometric(
+    word *alleles, double &tolerance, const double &mu,
+    const Architecture &arch, rnd::generator &rng
+) {
+
+    // Prepare a next mutation sampler
+    auto getNextMutant = rnd::Geometric(mu);
+
+    // Initialize
+    size_t i = getNextMutant(rng);
+
+    // Exit if no mutation
+    if (i >= arch.nloci) return;
+
+    // Prepare to count alleles 1 gained and lost
+    std::ptrdiff_t gained = 0;
+
+    // For as long as it takes...
+    while (i < arch.nloci) {
+
+        // Flip the sampled position
+        toggle(alleles, i);
+
+        // Record
+        gained += test(alleles, i) ? 1 : -1;
+
+        // Sample the next mutation
+        i += getNextMutant(rng) + 1u;
+
+    }
+
+    // Check
+    assert(i >= arch.nloci);
+
+    // Update trait value (from the count of alleles 1 if effects are equal)
+    tolerance = arch.uniform ? recount(tolerance, gained, arch) : evaluate(alleles, arch);
+
+}
+
+// Function to mutate using binomial sampling
+void gen::mutateBinomial(
+    word *alleles, double &tolerance, const double &mu,
+    const Architecture &arch, rnd::generator &rng
+) {
+
+    // Sample the number of mutations
+    size_t n = rnd::Binomial(arch.nloci, mu)(rng);
+
+    // Check
+    assert(n <= arch.nloci);
+
+    // Exit if zero
+    if (n == 0u) return;
+
+    // If needed...
+    if (n == arch.nloci) {
+
+        // Mutate all loci
+        flipall(alleles, tolerance, arch);
+
+        // Exit
+        return;
+
+    }
+
+    // Prepare a locus sampler
+    auto sampleLocus = rnd::Random(0u, arch.nloci - 1u);
+
+    // Prepare to record mutated loci
+    word *mutated = scratch(MARKS, arch.nwords);
+
+    // Only clear the words in use
+    std::fill_n(mutated, arch.nwords, word(0u));
+
+    // For as long as it takes...
+    while (n > 0u) {
+
+        // Sample a random locus
+        const size_t i = sampleLocus(rng);
+
+        // Check
+        assert(i < arch.nloci);
+
+        // If it has not been hit yet...
+        if (!test(mutated, i)) {
+
+            // Record
+            toggle(mutated, i);
+
+            // Update counter
+            --n;
+
+        }
+    }
+
+    // Check
+    assert(n == 0u);
+
+    // Flip the mutated loci
+    for (size_t w = 0u; w < arch.nwords; ++w) alleles[w] ^= mutated[w];
+
+    // Update trait value
+    tolerance = evaluate(alleles, arch);
+
+}
+
+// Function to mutate the genome
+void gen::mutate(
+    word *alleles, double &tolerance, const double &mu,
+    const Architecture &arch, rnd::generator &rng
+) {
+
+    // alleles: words of the genome
+    // tolerance: trait value to update
+    // mu: mutation rate
+    // arch: genetic architecture
+    // rng: random number generator
+
+    // No mutation if the rate is zero
+    if (mu == 0.0) return;
+
+    // If the rate is one...
+    if (mu == 1.0) {
+
+        // Mutate all loci
+        flipall(alleles, tolerance, arch);
+
+        // Exit
+        return;
+
+    }
+
+    // Depending on the muation rate...
+    if (mu < 0.01) {
+
+        // Mutate using geometric sampling
+        mutateGeometric(alleles, tolerance, mu, arch, rng);
+
+    } else if (mu < 0.1) {
+
+        // Mutate using binomial sampling
+        mutateBinomial(alleles, tolerance, mu, arch, rng);
+
+    } else if (mu < 0.9) {
+
+        // Mutate using shuffle sampling
+        mutateShuffle(alleles, tolerance, mu, arch, rng);
+
+    } else {
+
+        // Mutate using Bernoulli sampling
+        mutateBernoulli(alleles, tolerance, mu, arch, rng);
+
+    }
+}
+
+// Function to recombine genome with a pollen donor
+void gen::recombine(
+    word *alleles, double &tolerance, const word *pollen, const double &rho,
+    const Architecture &arch, rnd::generator &rng, const Diversity *diversity
+) {
+
+    // alleles: words of the genome
+    // tolerance: trait value to update
+    // pollen: words of the genome of the pollen donor
+    // rho: recombination rate
+    // arch: genetic architecture
+    // rng: random number generator
+    // diversity: survey of the loci that vary (if any)
+
+    // Note: the stretches of loci between crossovers that come from the
+    // pollen donor are spliced into the genome a whole word at a time, so the
+    // work done scales with the number of crossovers and the number of words
+    // taken from the pollen, not with the number of loci. With a survey, only
+    // the words with loci that vary are looked at. With equal effects
+    // the trait value is then updated from the number of alleles gained and
+    // lost, otherwise it is evaluated once at the end.
+
+    // Exit if no recombination
+    if (rho == 0.0) return;
+
+    // Check
+    assert(rho > 0.0);
+
+    // Crossovers are sampled from an exponential distribution
+    auto getNextCrossover = rnd::Exponential(rho);
+
+    /// Sample the first crossover point
+    double crossover = getNextCrossover(rng);
+
+    // Sample the starting haplotype
+    size_t hap = rnd::Bernoulli(0.5)(rng);
+
+    // Position of the last locus
+    const double end = arch.locations.back();
+
+    // Prepare to know if anything changes
+    word changed = 0u;
+
+    // Prepare to count alleles 1 gained and lost
+    std::ptrdiff_t gained = 0;
+
+    // Whether some words are known to be fixed
+    const bool pruned = diversity && diversity->words.size() < arch.nwords;
+
+    // Function to take the alleles of a stretch of loci from the pollen
+    auto take = [&](const size_t &from, const size_t &to) {
+
+        // Nothing to do if the stretch is empty
+        if (from == to) return;
+
+        // Words containing the first and last loci
+        const size_t first = from / WORDBITS;
+        const size_t last = (to - 1u) / WORDBITS;
+
+        // Masks of the loci of the stretch within those words
+        const word head = ~word(0u) << (from % WORDBITS);
+        const word tail = ~word(0u) >> (WORDBITS - 1u - (to - 1u) % WORDBITS);
+
+        // Function to take the alleles of one of the words
+        auto splice = [&](const size_t &w) {
+
+            // Mask of the loci of the stretch within the word
+            const word mask = (w == first ? head : ~word(0u)) & (w == last ? tail : ~word(0u));
+
+            // Alleles that differ and are taken from the pollen
+            const word diff = (alleles[w] ^ pollen[w]) & mask;
+
+            // Count the alleles 1 gained and lost
+            gained += std::popcount(diff & pollen[w]);
+            gained -= std::popcount(diff & alleles[w]);
+
+            // Take those alleles from the pollen
+            alleles[w] ^= diff;
+
+            // Record
+            changed |= diff;
+
+        };
+
+        // Go through each of those words, unless some are known to be fixed
+        if (!pruned) { for (size_t w = first; w <= last; ++w) splice(w); return; }
+
+        // Otherwise only through those with loci that vary
+        auto it = std::lower_bound(diversity->words.begin(), diversity->words.end(), first);
+        for (; it != diversity->words.end() && *it <= last; ++it) splice(*it);
+
+    };
+
+    // Note: fixed loci carry the same alleles in both parents (e.g. adults of
+    // the population surveyed, not yet mutated), so words where every locus
+    // is fixed would be left unchanged anyway.
+
+    // First locus of the current stretch of haplotype
+    size_t from = 0u;
+
+    // For as long as crossovers fall before the last locus...
+    while (crossover < end) {
+
+        // Loci up to the crossover are on the current haplotype
+        const size_t to = arch.locate(crossover);
+
+        // Take them if they are on the pollen haplotype
+        if (hap) take(from, to);
+
+        // Switch haplotype
+        hap = hap ? 0u : 1u;
+
+        // Move on
+        from = to;
+
+        // Update current crossover location
+        crossover += getNextCrossover(rng);
+
+    }
+
+    // The remaining loci are on the current haplotype
+    if (hap) take(from, arch.nloci);
+
+    // Exit if nothing has changed
+    if (!changed) return;
+
+    // With equal effects, update the trait value from the count of alleles 1
+    if (arch.uniform) { tolerance = recount(tolerance, gained, arch); return; }
+
+    // Otherwise evaluate it (fixed words being untouched, they can still be
+    // left out)
+    tolerance = evaluate(alleles, arch, diversity);
+
+}
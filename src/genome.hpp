@@ -0,0 +1,130 @@
+#ifndef BRACHYPODE_GENOME_HPP
+#define BRACHYPODE_GENOME_HPP
+
+// This is the header for the gen (genome) namespace. It contains the operations
+// performed on genomes, which are stored as arrays of 64-bit words (one bit per
+// locus). Only as many words as needed for the number of loci of the genetic
+// architecture are used (see Architecture::nwords), up to gen::MAXLOCI loci.
+// Genomes being put together or read back are kept in scratch space sized to
+// that number of words, of which each thread has its own (see gen::scratch).
+// Working on raw words allows the same functions to be used on the genome of a
+// single Individual as well as on genomes packed next to each other in a
+// columnar store of individuals. Functions that change alleles also update the
+// trait value they are given. Those that change many alleles at once rewrite
+// whole words and then evaluate the trait value from scratch (see
+// gen::evaluate), which is cheaper than updating it locus by locus and keeps
+// rounding errors from building up over generations. With equal effects, the
+// number of alleles 1 gained and lost is enough to get the exact same value
+// (see gen::recount), and mutations then only cost as much as the loci they
+// hit.
+//
+// A gen::Diversity records which loci vary across a set of genomes (e.g. the
+// whole population) using word-level AND and OR reductions. Words where every
+// locus is fixed can then be left out of recombination between genomes of the
+// set (both parents carry the same alleles there), and out of evaluation, their
+// share of the trait value being folded into a constant offset, for as long as
+// they do not mutate.
+
+#include "architecture.hpp"
+#include "random.hpp"
+#include "kernels.hpp"
+
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <numeric>
+#include <algorithm>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cmath>
+
+namespace gen {
+
+    // Type of the words the alleles are packed into
+    typedef std::uint64_t word;
+
+    // Number of bits in a word
+    constexpr size_t WORDBITS = 64u;
+
+    // Maximum number of loci in a genome
+    constexpr size_t MAXLOCI = 100000u;
+
+    // Maximum number of words in a genome
+    constexpr size_t NWORDS = (MAXLOCI + WORDBITS - 1u) / WORDBITS;
+
+    // Note: those are limits to check against, buffers are sized at runtime.
+
+    // Scratch genomes of each thread, one per use (as they can be in use at once)
+    constexpr size_t SEED = 0u;    // seed being put together
+    constexpr size_t POLLEN = 1u;  // genome of a pollen donor read back
+    constexpr size_t MARKS = 2u;   // loci marked by a function (e.g. already mutated)
+    constexpr size_t COPY = 3u;    // genome read back to be copied or surveyed
+    constexpr size_t NSCRATCH = 4u;
+
+    // Function to borrow scratch space for a genome
+    word* scratch(const size_t&, const size_t&);
+
+    // Bit-level functions
+    bool test(const word*, const size_t&);
+    void toggle(word*, const size_t&);
+    void fill(word*, const size_t&, const size_t&);
+    size_t count(const word*, const size_t&);
+
+    // Conversion to and from lists of positions of loci carrying allele 1
+    void encode(const word*, const size_t&, std::vector<std::uint16_t>&);
+    void decode(const std::uint16_t*, const size_t&, word*, const size_t&);
+
+    // Survey of the loci that vary across a set of genomes
+    struct Diversity {
+
+        // Constructor
+        Diversity(const size_t&);
+
+        // Setters
+        void reset();
+        void add(const word*);
+        void close(const Architecture&);
+
+        // Function to tell whether a word has loci that vary
+        bool active(const size_t &w) const { assert(w < nwords); return any[w] != all[w]; };
+
+        // Function to return the number of loci that vary
+        size_t polymorphic() const;
+
+        // Number of words per genome
+        size_t nwords;
+
+        // Reductions over the genomes surveyed
+        std::vector<word> all;           // loci carrying allele 1 in every genome
+        std::vector<word> any;           // loci carrying allele 1 in at least one genome
+
+        // Summary (once closed)
+        std::vector<size_t> words;       // words with loci that vary
+        std::vector<double> sums;        // trait value carried by each word without
+        double offset;                   // trait value carried by all the words without
+
+    };
+
+    // Trait value of a whole genome
+    double evaluate(const word*, const Architecture&);
+    double evaluate(const word*, const Architecture&, const Diversity*);
+    double recount(const double&, const std::ptrdiff_t&, const Architecture&);
+
+    // Allele-level functions
+    void flip(word*, double&, const size_t&, const Architecture&);
+    void flipall(word*, double&, const Architecture&);
+
+    // Mutation samplers
+    void mutateBernoulli(word*, double&, const double&, const Architecture&, rnd::generator&);
+    void mutateShuffle(word*, double&, const double&, const Architecture&, rnd::generator&);
+    void mutateGeometric(word*, double&, const double&, const Architecture&, rnd::generator&);
+    void mutateBinomial(word*, double&, const double&, const Architecture&, rnd::generator&);
+
+    // Genome-level functions
+    void mutate(word*, double&, const double&, const Architecture&, rnd::generator&);
+    void recombine(word*, double&, const word*, const double&, const Architecture&, rnd::generator&, const Diversity* = nullptr);
+
+}
+
+#endif
@@ -3,13 +3,17 @@
 
 // This is the header for the Individual class. It contains all the basic elements an 
 // individual organism needs in the simulation such as trait values, genetic information,
-// and location in the landscape.
+// and location in the landscape. The genetic architecture is not stored within each
+// individual, and must be passed to the functions that need it.
 
 #include "random.hpp"
 #include "parameters.hpp"
 #include "architecture.hpp"
+#include "genome.hpp"
 
-#include <bitset>
+#include <cstdint>
+#include <vector>
+#include <limits>
 #include <cmath>
 
 class Individual {
@@ -17,17 +21,17 @@ class Individual {
 public:
 
     // Constructor
-    Individual(const double&, const std::shared_ptr<Architecture>&);
+    Individual(const double&, const Architecture&);
 
     // Setters
-    void mutate(const double&);
-    void recombine(const double&, const Individual&);
+    void mutate(const double&, const Architecture&, rnd::generator& = rnd::rng);
+    void recombine(const double&, const Individual&, const Architecture&, rnd::generator& = rnd::rng);
 
     // Mutation samplers
-    void mutateBernoulli(const double&);
-    void mutateShuffle(const double&);
-    void mutateGeometric(const double&);
-    void mutateBinomial(const double&);
+    void mutateBernoulli(const double&, const Architecture&, rnd::generator& = rnd::rng);
+    void mutateShuffle(const double&, const Architecture&, rnd::generator& = rnd::rng);
+    void mutateGeometric(const double&, const Architecture&, rnd::generator& = rnd::rng);
+    void mutateBinomial(const double&, const Architecture&, rnd::generator& = rnd::rng);
     
     // Resetters
     void setDeme(const size_t&);
@@ -39,9 +43,10 @@ public:
     size_t getDeme() const { return deme; };
     size_t getPatch() const { return patch; };
     size_t getNSeeds() const { return nseeds; };
-    size_t getAllele(const size_t &i) const { assert(i < alleles.size()); return alleles.test(i); }
-    size_t countAlleles() const { return alleles.count(); };
+    size_t getAllele(const size_t &i) const { assert(i < alleles.size() * gen::WORDBITS); return gen::test(alleles.data(), i); }
+    size_t countAlleles() const { return gen::count(alleles.data(), alleles.size()); };
     double getTolerance() const { return tolerance; };
+    const gen::word* getGenome() const { return alleles.data(); };
 
     // Checker
     void check(const size_t&);
@@ -50,20 +55,16 @@ private:
 
     // Attributes
     double tolerance;
-    size_t deme;
-    size_t patch;
-    size_t nseeds;
+    std::uint32_t deme;
+    std::uint8_t patch;
+    std::uint32_t nseeds;
 
-    // Alleles as a bitset
-    std::bitset<1000> alleles;
-
-    // Pointer to shared genetic parameters
-    std::shared_ptr<Architecture> architecture;
+    // Alleles packed into words (as many as the architecture needs)
+    std::vector<gen::word> alleles;
 
     // Private setters
-    void flip(const size_t&);
-    void flipall();
-    
+    void flip(const size_t&, const Architecture&);
+
 };
 
 #endif
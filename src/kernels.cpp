@@ -0,0 +1,220 @@
+// This script contains the functions of the krn namespace.
+
+#include "kernels.hpp"
+
+// Note: the exponential is computed as exp(x) = 2^k exp(r), where k is the
+// integer nearest to x / ln(2) and |r| <= ln(2) / 2. The factor exp(r) is
+// approximated by its Taylor polynomial of degree 8, whose relative error is
+// below 2e-10 over that range, and 2^k is built directly from its bits. Inputs
+// are clamped to [-708, 709], so results are always finite and positive (the
+// exponential of anything below -708 is taken to be about 3e-308).
+
+// Constants of the approximation
+constexpr double EXPMIN = -708.0;
+constexpr double EXPMAX = 709.0;
+constexpr double LOG2E = 1.4426950408889634;         // 1 / ln(2)
+constexpr double LN2HI = 6.93147180369123816490e-01; // ln(2), leading bits
+constexpr double LN2LO = 1.90821492927058770002e-10; // ln(2), trailing bits
+
+// Taylor coefficients 1 / n!
+constexpr double C2 = 1.0 / 2.0;
+constexpr double C3 = 1.0 / 6.0;
+constexpr double C4 = 1.0 / 24.0;
+constexpr double C5 = 1.0 / 120.0;
+constexpr double C6 = 1.0 / 720.0;
+constexpr double C7 = 1.0 / 5040.0;
+constexpr double C8 = 1.0 / 40320.0;
+
+// Approximate exponential
+double krn::exp(const double &x) {
+
+    // x: value to exponentiate
+
+    // Clamp
+    const double y = std::min(std::max(x, EXPMIN), EXPMAX);
+
+    // Nearest power of two
+    const double k = std::nearbyint(y * LOG2E);
+
+    // Remainder (ln(2) is split in two for accuracy)
+    const double r = (y - k * LN2HI) - k * LN2LO;
+
+    // Polynomial, by Horner's scheme
+    double p = C8;
+    p = p * r + C7;
+    p = p * r + C6;
+    p = p * r + C5;
+    p = p * r + C4;
+    p = p * r + C3;
+    p = p * r + C2;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // Power of two, from its exponent bits
+    const double scale = std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(k) + 1023) << 52u);
+
+    // Exit
+    return p * scale;
+
+}
+
+// Function to exponentiate a block of values in place
+void krn::exps(double *x, const size_t &n) {
+
+    // x: values to exponentiate
+    // n: number of values
+
+    // Index of the current value
+    size_t j = 0u;
+
+#ifdef __AVX2__
+
+    // Note: this mirrors the scalar version step by step, without fused
+    // multiply-adds, so both give the same results (this file is built with
+    // contraction turned off, so the compiler does not fuse them either).
+
+    // Constants
+    const __m256d lo = _mm256_set1_pd(EXPMIN);
+    const __m256d hi = _mm256_set1_pd(EXPMAX);
+    const __m256d log2e = _mm256_set1_pd(LOG2E);
+    const __m256d ln2hi = _mm256_set1_pd(LN2HI);
+    const __m256d ln2lo = _mm256_set1_pd(LN2LO);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0); // 2^52 + 2^51
+    const __m256i bias = _mm256_set1_epi64x(1023);
+
+    // For each block of four values...
+    for (; j + 4u <= n; j += 4u) {
+
+        // Clamp
+        const __m256d y = _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(x + j), lo), hi);
+
+        // Nearest power of two
+        const __m256d k = _mm256_round_pd(_mm256_mul_pd(y, log2e), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+        // Remainder
+        const __m256d r = _mm256_sub_pd(_mm256_sub_pd(y, _mm256_mul_pd(k, ln2hi)), _mm256_mul_pd(k, ln2lo));
+
+        // Polynomial
+        __m256d p = _mm256_set1_pd(C8);
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C7));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C6));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C5));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C4));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C3));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), _mm256_set1_pd(C2));
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), one);
+        p = _mm256_add_pd(_mm256_mul_pd(p, r), one);
+
+        // Integer value of k, read from the low bits of k + 2^52 + 2^51
+        const __m256i kint = _mm256_castpd_si256(_mm256_add_pd(k, magic));
+
+        // Power of two, from its exponent bits (the high bits are shifted out)
+        const __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(kint, bias), 52));
+
+        // Store
+        _mm256_storeu_pd(x + j, _mm256_mul_pd(p, scale));
+
+    }
+
+#endif
+
+    // Remaining values (or all of them without AVX2)
+    for (; j < n; ++j) x[j] = exp(x[j]);
+
+}
+
+// Function to compute expected numbers of seeds for a block of plants
+void krn::fecundity(
+    double *w, const double *x, const double *c, const size_t &n,
+    const double &xmax, const double &rmax, const double &epsilon, const double &nu
+) {
+
+    // w: where to write the expected numbers of seeds
+    // x: trait values
+    // c: crowding terms (one minus local density over carrying capacity)
+    // n: number of plants
+    // xmax: maximum trait value
+    // rmax: maximum growth rate
+    // epsilon: trade-off strength
+    // nu: trade-off non-linearity
+
+    // Note: this is the Ricker fitness exp(r c), where r is the growth rate
+    // given by the trade-off function (see pop::growth and pop::ricker).
+
+    // Check
+    assert(xmax != 0.0);
+
+    // If the trade-off is linear...
+    if (nu == 1.0) {
+
+        // Compute growth rates (this loop vectorizes on its own)
+        for (size_t j = 0u; j < n; ++j) w[j] = std::max(rmax - epsilon * x[j], 0.0);
+
+    } else {
+
+        // Otherwise compute them one by one
+        for (size_t j = 0u; j < n; ++j)
+            w[j] = std::max(rmax - epsilon * xmax * utl::power(x[j] / xmax, nu), 0.0);
+
+    }
+
+    // Multiply by the crowding terms
+    for (size_t j = 0u; j < n; ++j) w[j] *= c[j];
+
+    // Exponentiate
+    exps(w, n);
+
+}
+
+// Function to sum the values picked by the bits set in an array of words
+double krn::dot(const std::uint64_t *bits, const double *values, const size_t &n) {
+
+    // bits: words whose bits pick the values to sum (e.g. a genome)
+    // values: values to pick from (e.g. effects of the loci)
+    // n: number of values (and of bits to read)
+
+    // Note: value i goes into partial sum i % 4, and the partial sums are
+    // added up in the same order at the end, whichever path is taken. Values
+    // that are not picked add zero, which leaves the sums unchanged.
+
+    // Partial sums
+    std::array<double, 4u> sums = {0.0, 0.0, 0.0, 0.0};
+
+    // Index of the current value
+    size_t i = 0u;
+
+#ifdef __AVX2__
+
+    // Bit of each lane within a group of four
+    const __m256i lanes = _mm256_set_epi64x(8, 4, 2, 1);
+
+    // Partial sums
+    __m256d acc = _mm256_setzero_pd();
+
+    // For each group of four values...
+    for (; i + 4u <= n; i += 4u) {
+
+        // Bits of the group, spread over the lanes
+        const __m256i group = _mm256_set1_epi64x((bits[i / 64u] >> (i % 64u)) & 0xfu);
+
+        // All ones in the lanes whose bit is set
+        const __m256i mask = _mm256_cmpeq_epi64(_mm256_and_si256(group, lanes), lanes);
+
+        // Add the values picked
+        acc = _mm256_add_pd(acc, _mm256_and_pd(_mm256_loadu_pd(values + i), _mm256_castsi256_pd(mask)));
+
+    }
+
+    // Unpack the partial sums
+    _mm256_storeu_pd(sums.data(), acc);
+
+#endif
+
+    // Remaining values (or all of them without AVX2)
+    for (; i < n; ++i) sums[i % 4u] += (bits[i / 64u] >> (i % 64u)) & 1u ? values[i] : 0.0;
+
+    // Add up the partial sums
+    return (sums[0u] + sums[1u]) + (sums[2u] + sums[3u]);
+
+}
@@ -0,0 +1,42 @@
+#ifndef BRACHYPODE_KERNELS_HPP
+#define BRACHYPODE_KERNELS_HPP
+
+// This is the header for the krn (kernels) namespace. It contains functions
+// that compute the same quantity for a whole block of values at once, in a way
+// that lends itself to vectorization. If the program is built for a processor
+// with AVX2 instructions (e.g. with -march=native), four values are processed
+// per instruction. Otherwise a scalar fallback that performs exactly the same
+// arithmetic is used, so results do not depend on which path is taken.
+
+// Example usage:
+//
+// Expected numbers of seeds of n plants
+// krn::fecundity(w, x, c, n, xmax, rmax, epsilon, nu);
+//
+// Sum of the effects of the loci whose bit is set in a genome
+// double x = krn::dot(alleles, effects, nloci);
+
+#include "utilities.hpp"
+
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <array>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace krn {
+
+    // Approximate exponential
+    double exp(const double&);
+
+    // Block functions
+    void exps(double*, const size_t&);
+    void fecundity(double*, const double*, const double*, const size_t&, const double&, const double&, const double&, const double&);
+    double dot(const std::uint64_t*, const double*, const size_t&);
+
+}
+
+#endif
@@ -0,0 +1,263 @@
+// This script contains the functions of the Mutator class.
+
+#include "mutator.hpp"
+
+// Constructor
+Mutator::Mutator(
+    const double &rate, const Architecture &arch, rnd::generator &rng,
+    const size_t &how, const gen::Diversity *survey
+) :
+    mu(rate),
+    architecture(arch),
+    diversity(survey),
+    sampler(how),
+    next(std::numeric_limits<size_t>::max()),
+    getGap(rnd::Geometric(rate > 0.0 && rate < 1.0 ? rate : 0.5))
+{
+
+    // rate: mutation rate
+    // arch: genetic architecture
+    // rng: random number generator
+    // how: which sampler to use
+    // survey: loci that vary across the genomes to mutate (if known)
+
+    // Check
+    assert(mu >= 0.0);
+    assert(mu <= 1.0);
+    assert(sampler != AUTO);
+    assert(sampler < NSAMPLERS);
+
+    // Start the sequence
+    restart(rng);
+
+}
+
+// Function to start a new sequence of genomes
+void Mutator::restart(rnd::generator &rng) {
+
+    // rng: random number generator
+
+    // Note: the geometric distribution is not used when the rate is zero
+    // (no mutation ever) or one (every locus mutates).
+
+    // Sample the position of the first mutation if needed
+    if (mu > 0.0 && mu < 1.0) next = getGap(rng);
+
+    // Every locus of the first genome mutates if the rate is one
+    if (mu == 1.0) next = 0u;
+
+}
+
+// Function to mutate the next genome in the sequence
+void Mutator::mutate(gen::word *alleles, double &tolerance, rnd::generator &rng) {
+
+    // alleles: words of the genome
+    // tolerance: trait value to update
+    // rng: random number generator
+
+    // Number of loci
+    const size_t nloci = architecture.nloci;
+
+    // If every locus mutates...
+    if (mu == 1.0) {
+
+        // Flip them all
+        gen::flipall(alleles, tolerance, architecture);
+
+        // Exit
+        return;
+
+    }
+
+    // If each genome is sampled on its own...
+    if (sampler != GAPS) {
+
+        // Nothing to do if mutations never happen
+        if (mu == 0.0) return;
+
+        // Mutate with the right sampler
+        if (sampler == BINOMIAL) gen::mutateBinomial(alleles, tolerance, mu, architecture, rng);
+        else if (sampler == SHUFFLE) gen::mutateShuffle(alleles, tolerance, mu, architecture, rng);
+        else gen::mutateBernoulli(alleles, tolerance, mu, architecture, rng);
+
+        // Exit
+        return;
+
+    }
+
+    // Prepare to know if the genome mutates
+    bool mutated = false;
+
+    // Prepare to count alleles 1 gained and lost
+    std::ptrdiff_t gained = 0;
+
+    // For as long as mutations fall within this genome...
+    while (next < nloci) {
+
+        // Flip the mutated locus
+        gen::toggle(alleles, next);
+
+        // Record
+        mutated = true;
+        gained += gen::test(alleles, next) ? 1 : -1;
+
+        // Sample the next mutation
+        next += getGap(rng) + 1u;
+
+    }
+
+    // Update trait value if needed (from the count of alleles 1 if effects are equal)
+    if (mutated && architecture.uniform) tolerance = gen::recount(tolerance, gained, architecture);
+    else if (mutated) tolerance = gen::evaluate(alleles, architecture, diversity);
+
+    // Move on to the next genome (unless mutations never happen)
+    if (next != std::numeric_limits<size_t>::max()) next -= nloci;
+
+}
+
+// Function to skip over genomes that do not mutate
+size_t Mutator::skip(const size_t &n) {
+
+    // n: maximum number of genomes to skip
+
+    // Note: this returns the number of genomes, out of the next n, that come
+    // before the next mutation. Those genomes are passed over without being
+    // touched, and the genome after them (if any) is the next to mutate.
+
+    // All genomes can be skipped if mutations never happen
+    if (mu == 0.0) return n;
+
+    // None can if every locus mutates
+    if (mu == 1.0) return 0u;
+
+    // None can either if genomes are sampled one by one
+    if (sampler != GAPS) return 0u;
+
+    // Note: in that case every genome is built and goes through the sampler,
+    // whether it ends up mutating or not.
+
+    // Number of whole genomes before the next mutation
+    const size_t k = std::min(n, next / architecture.nloci);
+
+    // Move past them
+    next -= k * architecture.nloci;
+
+    // Exit
+    return k;
+
+}
+
+// Function to time the samplers and pick the fastest one
+size_t Mutator::tune(const double &rate, const Architecture &arch, std::vector<double> &timings, const size_t &engine) {
+
+    // rate: mutation rate
+    // arch: genetic architecture
+    // timings: where to record the time per genome of each sampler (in ns)
+    // engine: random number engine of the simulation (see Population::engine)
+
+    // Note: each sampler mutates the same number of genomes a few times over,
+    // and the best of those times is kept. Draws come from a generator of
+    // their own, so tuning does not change the course of the simulation.
+
+    // Number of genomes to mutate and number of repeats
+    constexpr size_t NGENOMES = 4096u;
+    constexpr size_t NREPEATS = 3u;
+
+    // Prepare to record timings (none for automatic picking)
+    timings.assign(NSAMPLERS, 0.0);
+
+    // Random number generator used for timing (with the engine of the
+    // simulation, as the cost of a draw depends on it)
+    rnd::generator rng = engine == 1u ? rnd::generator(rnd::Philox()) :
+        engine == 2u ? rnd::generator(rnd::Block(0u)) : rnd::generator(0u);
+
+    // Genome to mutate over and over
+    std::vector<gen::word> alleles(arch.nwords, gen::word(0u));
+    double tolerance = 0.0;
+
+    // Fastest sampler so far
+    size_t best = GAPS;
+
+    // For each sampler...
+    for (size_t s = GAPS; s < NSAMPLERS; ++s) {
+
+        // Prepare a mutator
+        Mutator mutator(rate, arch, rng, s);
+
+        // Prepare to record the best time
+        double fastest = std::numeric_limits<double>::infinity();
+
+        // For each repeat...
+        for (size_t r = 0u; r < NREPEATS; ++r) {
+
+            // Start the clock
+            const auto start = std::chrono::steady_clock::now();
+
+            // Mutate many genomes
+            for (size_t i = 0u; i < NGENOMES; ++i) mutator.mutate(alleles.data(), tolerance, rng);
+
+            // Stop the clock
+            const auto stop = std::chrono::steady_clock::now();
+
+            // Time per genome
+            const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / NGENOMES;
+
+            // Keep the best
+            fastest = std::min(fastest, ns);
+
+        }
+
+        // Record
+        timings[s] = fastest;
+
+        // Update the fastest sampler
+        if (fastest < timings[best]) best = s;
+
+    }
+
+    // Exit
+    return best;
+
+}
+
+// Function to append the timings of the samplers to a file
+void Mutator::report(const std::string &filename, const std::vector<double> &timings) {
+
+    // filename: name of the file to append to
+    // timings: time per genome of each sampler (in ns)
+
+    // Note: lines are written as comments, so a parameter file can still be
+    // read back from the file.
+
+    // Open the file
+    std::ofstream file(filename, std::ios::app);
+
+    // Check if the file is open
+    if (!file.is_open())
+        throw std::runtime_error("Unable to open file " + filename);
+
+    // Write the time taken by each sampler
+    report(file, timings);
+
+    // Close the file
+    file.close();
+
+}
+
+// Function to write the timings of the samplers to a stream
+void Mutator::report(std::ostream &out, const std::vector<double> &timings) {
+
+    // out: stream to write to (e.g. the screen)
+    // timings: time per genome of each sampler (in ns)
+
+    // Names of the samplers
+    const std::array<std::string, NSAMPLERS> names = {"auto", "gaps", "binomial", "shuffle", "bernoulli"};
+
+    // Check
+    assert(timings.size() == NSAMPLERS);
+
+    // Write the time taken by each sampler
+    for (size_t s = GAPS; s < NSAMPLERS; ++s)
+        out << "# sampler " << s << " (" << names[s] << ") takes " << timings[s] << " ns per genome\n";
+
+}
@@ -0,0 +1,92 @@
+#ifndef BRACHYPODE_MUTATOR_HPP
+#define BRACHYPODE_MUTATOR_HPP
+
+// This is the header for the Mutator class. A Mutator samples mutations over a
+// whole sequence of genomes, as if those genomes were laid end to end into one
+// long array of loci. The distance to the next mutation is drawn from a single
+// geometric distribution and carries over from one genome to the next, so the
+// number of random draws is proportional to the number of mutations, and not
+// to the number of genomes (most of which, at low mutation rates, do not
+// mutate at all).
+//
+// At high mutation rates, or with few loci, sampling each genome on its own can
+// be faster. The Mutator can then use one of the per-genome samplers of the gen
+// namespace instead (see Mutator::tune to time them all and pick the fastest).
+
+// Example usage:
+//
+// Prepare a mutator
+// Mutator mutator(mu, arch, rng);
+//
+// Or pick the fastest sampler first
+// std::vector<double> timings;
+// Mutator mutator(mu, arch, rng, Mutator::tune(mu, arch, timings));
+//
+// Mutate genomes one after the other
+// for (size_t i = 0u; i < store.size(); ++i)
+//     mutator.mutate(store.genome(i), store.tolerances[i], rng);
+
+#include "genome.hpp"
+#include "architecture.hpp"
+#include "random.hpp"
+
+#include <limits>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+class Mutator {
+
+public:
+
+    // Samplers
+    static constexpr size_t AUTO = 0u;      // to be picked by timing them all
+    static constexpr size_t GAPS = 1u;      // gaps between mutations across genomes
+    static constexpr size_t BINOMIAL = 2u;  // number of mutations, then random loci
+    static constexpr size_t SHUFFLE = 3u;   // number of mutations, then distinct loci
+    static constexpr size_t BERNOULLI = 4u; // one trial per locus, 64 at a time
+    static constexpr size_t NSAMPLERS = 5u;
+
+    // Constructor
+    Mutator(const double&, const Architecture&, rnd::generator&, const size_t& = GAPS, const gen::Diversity* = nullptr);
+
+    // Functions to time the samplers and pick the fastest one
+    static size_t tune(const double&, const Architecture&, std::vector<double>&, const size_t& = 0u);
+    static void report(const std::string&, const std::vector<double>&);
+    static void report(std::ostream&, const std::vector<double>&);
+
+    // Function to start a new sequence of genomes
+    void restart(rnd::generator&);
+
+    // Function to mutate the next genome in the sequence
+    void mutate(gen::word*, double&, rnd::generator&);
+
+    // Function to skip over genomes that do not mutate
+    size_t skip(const size_t&);
+
+private:
+
+    // Mutation rate
+    double mu;
+
+    // Genetic architecture
+    const Architecture &architecture;
+
+    // Loci that vary across the genomes to mutate (if known)
+    const gen::Diversity *diversity;
+
+    // Which sampler to use
+    size_t sampler;
+
+    // Distance to the next mutation, from the start of the next genome
+    size_t next;
+
+    // Sampler of distances between consecutive mutations
+    rnd::Geometric getGap;
+
+};
+
+#endif
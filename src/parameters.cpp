@@ -26,6 +26,7 @@ Parameters::Parameters(const std::string &filename) :
     steep(2.0),
     dispersal(0.01),
     mutation(0.0001),
+    sampler(1u),
     nloci(10u),
     effect(0.1),
     allfreq(0.1),
@@ -40,6 +41,15 @@ Parameters::Parameters(const std::string &filename) :
     tchange(100000u),
     twarming(1u),
     seed(clockseed()),
+    engine(0u),
+    nthreads(1u),
+    splitting(false),
+    vectorize(false),
+    pooling(false),
+    cohorts(false),
+    pruning(false),
+    sparse(false),
+    batching(false),
     sow(false),
     loadarch(false),
     savepars(false),
@@ -78,7 +88,8 @@ void Parameters::check() const {
     assert(steep >= 0.0);
     assert(dispersal >= 0.0 && dispersal <= 1.0);
     assert(mutation >= 0.0 && mutation <= 1.0);
-    assert(nloci > 0u && nloci <= 1000u);
+    assert(sampler < 5u);
+    assert(nloci > 0u && nloci <= 100000u);
     assert(effect > 0.0);
     assert(allfreq >= 0.0 && allfreq <= 1.0);
     assert(tradeoff >= 0.0);
@@ -90,6 +101,8 @@ void Parameters::check() const {
     assert(tend > 0u);
     assert(tsave > 0u);
     assert(twarming > 0u);
+    assert(nthreads > 0u);
+    assert(engine < 3u);
 
 }
 
@@ -137,7 +150,8 @@ void Parameters::read(const std::string &filename)
         else if (name == "steep") reader.readvalue<double>(steep, chk::positive<double>);
         else if (name == "dispersal") reader.readvalue<double>(dispersal, chk::proportion<double>);
         else if (name == "mutation") reader.readvalue<double>(mutation, chk::proportion<double>);
-        else if (name == "nloci") reader.readvalue<size_t>(nloci, chk::onetothousand<size_t>);
+        else if (name == "sampler") reader.readvalue<size_t>(sampler, chk::sampler<size_t>);
+        else if (name == "nloci") reader.readvalue<size_t>(nloci, chk::onetohundredthousand<size_t>);
         else if (name == "effect") reader.readvalue<double>(effect, chk::strictpos<double>);
         else if (name == "allfreq") reader.readvalue<double>(allfreq, chk::proportion<double>);
         else if (name == "tradeoff") reader.readvalue<double>(tradeoff, chk::positive<double>);
@@ -151,6 +165,15 @@ void Parameters::read(const std::string &filename)
         else if (name == "tchange") reader.readvalue<size_t>(tchange);
         else if (name == "twarming") reader.readvalue<size_t>(twarming, chk::strictpos<size_t>);
         else if (name == "seed") reader.readvalue<size_t>(seed);
+        else if (name == "engine") reader.readvalue<size_t>(engine, chk::engine<size_t>);
+        else if (name == "nthreads") reader.readvalue<size_t>(nthreads, chk::strictpos<size_t>);
+        else if (name == "splitting") reader.readvalue<bool>(splitting);
+        else if (name == "vectorize") reader.readvalue<bool>(vectorize);
+        else if (name == "pooling") reader.readvalue<bool>(pooling);
+        else if (name == "cohorts") reader.readvalue<bool>(cohorts);
+        else if (name == "pruning") reader.readvalue<bool>(pruning);
+        else if (name == "sparse") reader.readvalue<bool>(sparse);
+        else if (name == "batching") reader.readvalue<bool>(batching);
         else if (name == "sow") reader.readvalue<bool>(sow);
         else if (name == "loadarch") reader.readvalue<bool>(loadarch);
         else if (name == "savepars") reader.readvalue<bool>(savepars);
@@ -201,6 +224,7 @@ void Parameters::save(const std::string &filename) const
     file << "steep " << steep << '\n';
     file << "dispersal " << dispersal << '\n';
     file << "mutation " << mutation << '\n';
+    file << "sampler " << sampler << '\n';
     file << "nloci " << nloci << '\n';
     file << "effect " << effect << '\n';
     file << "allfreq " << allfreq << '\n';
@@ -215,6 +239,15 @@ void Parameters::save(const std::string &filename) const
     file << "tchange " << tchange << '\n';
     file << "twarming " << twarming << '\n';
     file << "seed " << seed << '\n';
+    file << "engine " << engine << '\n';
+    file << "nthreads " << nthreads << '\n';
+    file << "splitting " << splitting << '\n';
+    file << "vectorize " << vectorize << '\n';
+    file << "pooling " << pooling << '\n';
+    file << "cohorts " << cohorts << '\n';
+    file << "pruning " << pruning << '\n';
+    file << "sparse " << sparse << '\n';
+    file << "batching " << batching << '\n';
     file << "sow " << sow << '\n';
     file << "loadarch " << loadarch << '\n';
     file << "savepars " << savepars << '\n';
@@ -34,6 +34,7 @@ struct Parameters {
     double steep;                      // steepness of tolerance function
     double dispersal;                  // dispersal rate
     double mutation;                   // mutation rate
+    size_t sampler;                    // mutation sampler (0 to pick the fastest)
     size_t nloci;                      // number of loci
     double effect;                     // locus effect size
     double allfreq;                    // initial frequency of allele 1
@@ -48,6 +49,15 @@ struct Parameters {
     size_t tchange;                    // time to initiate warming
     size_t twarming;                   // duration of the warming period
     size_t seed;                       // seed for random number generator
+    size_t engine;                     // random number engine of the life cycle
+    size_t nthreads;                   // number of threads to use
+    bool splitting;                    // split seed fates with binomial draws
+    bool vectorize;                    // compute fecundities in blocks
+    bool pooling;                      // share identical genomes in a pool
+    bool cohorts;                      // simulate genotype classes instead of individuals
+    bool pruning;                      // leave out loci fixed in the population
+    bool sparse;                       // store genomes as lists of positions when smaller
+    bool batching;                     // draw seed fates ahead of building the seeds
     bool sow;                          // sow individuals at random
     bool loadarch;                     // load genetic architecture from file
     bool savepars;                     // save parameters to file
@@ -0,0 +1,221 @@
+// This script contains the functions of the Pool class.
+
+#include "pool.hpp"
+
+// Constructor
+Pool::Pool(const size_t &n) :
+    nwords(n),
+    words(std::vector<gen::word>()),
+    counts(std::vector<std::uint32_t>()),
+    hashes(std::vector<size_t>()),
+    freed(std::vector<std::uint32_t>()),
+    table(std::vector<std::uint32_t>(16u, EMPTY)),
+    nlive(0u),
+    nerased(0u)
+{
+
+    // n: number of words per genome
+
+    // Check
+    assert(nwords > 0u);
+    assert(nwords <= gen::NWORDS);
+
+}
+
+// Function to hash a genome
+size_t Pool::hash(const gen::word *alleles) const {
+
+    // alleles: words of the genome
+
+    // Prepare
+    size_t x = nwords;
+
+    // Fold each word in
+    for (size_t w = 0u; w < nwords; ++w) {
+        x ^= alleles[w] + 0x9e3779b97f4a7c15u + (x << 6u) + (x >> 2u);
+        x *= 0xbf58476d1ce4e5b9u;
+    }
+
+    // Scramble (so the low bits depend on all the others)
+    x ^= x >> 31u;
+    x *= 0x94d049bb133111ebu;
+
+    // Exit
+    return x ^ (x >> 29u);
+
+}
+
+// Function to rebuild the hash table with a given size
+void Pool::rehash(const size_t &n) {
+
+    // n: new size of the table (a power of two)
+
+    // Check
+    assert(std::has_single_bit(n));
+    assert(n > nlive);
+
+    // Start from an empty table
+    table.assign(n, EMPTY);
+
+    // No more erased entries
+    nerased = 0u;
+
+    // For each genome in use...
+    for (size_t h = 0u; h < counts.size(); ++h) {
+
+        // Skip free slots
+        if (!counts[h]) continue;
+
+        // Find the first empty entry from its hash
+        size_t pos = hashes[h] & (n - 1u);
+        while (table[pos] != EMPTY) pos = (pos + 1u) & (n - 1u);
+
+        // Record it there
+        table[pos] = h;
+
+    }
+}
+
+// Function to add a genome, or refer once more to an identical one
+size_t Pool::intern(const gen::word *alleles) {
+
+    // alleles: words of the genome
+
+    // Note: the table is probed linearly from the hash of the genome. Erased
+    // entries are passed over when looking for the genome, and the first of
+    // them is reused if the genome is not found.
+
+    // Keep the table at most half full (erased entries included)
+    if (2u * (nlive + nerased + 1u) > table.size())
+        rehash(std::max<size_t>(16u, std::bit_ceil(4u * (nlive + 1u))));
+
+    // Hash the genome
+    const size_t h = hash(alleles);
+
+    // Mask to wrap around the table
+    const size_t mask = table.size() - 1u;
+
+    // Start probing
+    size_t pos = h & mask;
+
+    // Prepare to record the first erased entry
+    size_t erased = table.size();
+
+    // Until an empty entry is reached...
+    while (table[pos] != EMPTY) {
+
+        // Handle of the entry
+        const std::uint32_t k = table[pos];
+
+        // Remember the first erased entry
+        if (k == ERASED) {
+            if (erased == table.size()) erased = pos;
+        }
+
+        // Or if the genome is already there...
+        else if (hashes[k] == h && std::equal(alleles, alleles + nwords, genome(k))) {
+
+            // Refer to it once more
+            ++counts[k];
+
+            // Exit
+            return k;
+
+        }
+
+        // Move on
+        pos = (pos + 1u) & mask;
+
+    }
+
+    // Otherwise find a slot for the genome (reusing a free one if possible)
+    size_t k = counts.size();
+    if (!freed.empty()) { k = freed.back(); freed.pop_back(); }
+
+    // Check
+    assert(k < ERASED);
+
+    // Make room if needed
+    if (k == counts.size()) {
+        counts.push_back(0u);
+        hashes.push_back(0u);
+        words.resize(words.size() + nwords);
+    }
+
+    // Copy the genome in
+    std::copy_n(alleles, nwords, words.begin() + k * nwords);
+
+    // Record it
+    counts[k] = 1u;
+    hashes[k] = h;
+
+    // Add it to the table (reusing an erased entry if possible)
+    if (erased < table.size()) { pos = erased; --nerased; }
+    table[pos] = k;
+
+    // Update
+    ++nlive;
+
+    // Exit
+    return k;
+
+}
+
+// Function to refer once more to a genome
+void Pool::acquire(const size_t &h) {
+
+    // h: handle of the genome
+
+    // Check
+    assert(h < counts.size());
+    assert(counts[h]);
+    assert(counts[h] < UINT32_MAX);
+
+    // Update
+    ++counts[h];
+
+}
+
+// Function to stop referring to a genome
+void Pool::release(const size_t &h) {
+
+    // h: handle of the genome
+
+    // Check
+    assert(h < counts.size());
+    assert(counts[h]);
+
+    // Update
+    --counts[h];
+
+    // Exit if the genome is still in use
+    if (counts[h]) return;
+
+    // Mask to wrap around the table
+    const size_t mask = table.size() - 1u;
+
+    // Find the genome in the table
+    size_t pos = hashes[h] & mask;
+    while (table[pos] != h) pos = (pos + 1u) & mask;
+
+    // Erase it
+    table[pos] = ERASED;
+    ++nerased;
+
+    // Free its slot
+    freed.push_back(h);
+    --nlive;
+
+}
+
+// Function to return the memory taken by the pool (in bytes)
+size_t Pool::memory() const {
+
+    // Add up the memory taken by each container
+    return words.capacity() * sizeof(gen::word) +
+        counts.capacity() * sizeof(std::uint32_t) +
+        hashes.capacity() * sizeof(size_t) +
+        freed.capacity() * sizeof(std::uint32_t) +
+        table.capacity() * sizeof(std::uint32_t);
+
+}
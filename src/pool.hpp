@@ -0,0 +1,82 @@
+#ifndef BRACHYPODE_POOL_HPP
+#define BRACHYPODE_POOL_HPP
+
+// This is the header for the Pool class, a shared store of genomes. Each
+// distinct genome is kept only once (hash-consing), and individuals refer to it
+// by a handle. The pool counts how many individuals refer to each genome, and
+// recycles the slot of a genome as soon as nobody refers to it anymore. In a
+// mostly selfing population, where nearly every seed is an exact copy of its
+// mother, this saves copying and storing the same genome over and over, and
+// tells whether two genomes are identical by just comparing their handles.
+
+// Example usage:
+//
+// Prepare a pool
+// Pool pool(arch.nwords);
+//
+// Add a genome (or refer to it once more if it is already there)
+// size_t h = pool.intern(alleles);
+//
+// Read it
+// const gen::word *genome = pool.genome(h);
+//
+// Let go of it
+// pool.release(h);
+
+#include "genome.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <bit>
+
+class Pool {
+
+public:
+
+    // Constructor
+    Pool(const size_t&);
+
+    // Setters
+    size_t intern(const gen::word*);
+    void acquire(const size_t&);
+    void release(const size_t&);
+
+    // Function to access a genome
+    const gen::word* genome(const size_t &h) const { assert(h < counts.size()); assert(counts[h]); return words.data() + h * nwords; };
+
+    // Function to return the number of references to a genome
+    size_t count(const size_t &h) const { assert(h < counts.size()); return counts[h]; };
+
+    // Function to return the number of distinct genomes
+    size_t unique() const { return nlive; };
+
+    // Function to return the memory taken by the pool (in bytes)
+    size_t memory() const;
+
+private:
+
+    // Markers of the hash table
+    static constexpr std::uint32_t EMPTY = UINT32_MAX;        // slot never used
+    static constexpr std::uint32_t ERASED = UINT32_MAX - 1u;  // slot used then freed
+
+    // Private functions
+    size_t hash(const gen::word*) const;
+    void rehash(const size_t&);
+
+    // Number of words per genome
+    size_t nwords;
+
+    // Genomes and their bookkeeping
+    std::vector<gen::word> words;        // genome arena (one genome per handle)
+    std::vector<std::uint32_t> counts;   // number of references to each genome
+    std::vector<size_t> hashes;          // hash of each genome
+    std::vector<std::uint32_t> freed;    // handles free to reuse
+    std::vector<std::uint32_t> table;    // hash table of handles (open addressing)
+    size_t nlive;                        // number of genomes in use
+    size_t nerased;                      // number of erased entries in the table
+
+};
+
+#endif
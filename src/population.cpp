@@ -4,8 +4,10 @@
 
 // Constructor
 Population::Population(const Parameters &pars, const Architecture &arch) :
-    individuals(std::make_unique<std::vector<Individual> >()),
-    newborns(std::make_unique<std::vector<Individual> >()),
+    pool(pars.pooling || pars.cohorts ? std::make_unique<Pool>(arch.nwords) : nullptr),
+    individuals(std::make_unique<Store>(arch.nwords, pool.get())),
+    newborns(std::make_unique<Store>(arch.nwords, pool.get())),
+    architecture(arch),
     ndemes(pars.ndemes),
     pgood(pars.pgood),
     pgoodEnd(pars.pgoodEnd),
@@ -17,6 +19,7 @@ Population::Population(const Parameters &pars, const Architecture &arch) :
     steep(pars.steep),
     dispersal(pars.dispersal),
     mutation(pars.mutation),
+    sampler(pars.sampler),
     tradeoff(pars.tradeoff),
     nonlinear(pars.nonlinear),
     selfing(pars.selfing),
@@ -28,33 +31,65 @@ Population::Population(const Parameters &pars, const Architecture &arch) :
     tchange(pars.tchange),
     twarming(pars.twarming),
     verbose(pars.verbose),
+    splitting(pars.splitting),
+    vectorize(pars.vectorize),
+    cohorts(pars.cohorts),
+    pruning(pars.pruning),
+    sparse(pars.sparse && !pars.pooling && !pars.cohorts && arch.nwords * gen::WORDBITS <= UINT16_MAX + 1u),
+    batching(pars.batching && !pars.splitting && !pars.cohorts),
+    seed(rnd::rng()),
+    nthreads(pars.nthreads),
+    engine(pars.engine),
     time(0u),
     popsize(pars.popsize),
+    nalleles(0u),
     demesizes(std::vector<size_t>(ndemes, 0u)),
     patchsizes(std::vector<size_t>(2u * ndemes, 0u)),
-    meantol(std::vector<double>(2u * ndemes, 0.0))
+    meantol(std::vector<double>(2u * ndemes, 0.0)),
+    buckets(std::vector<size_t>(2u * ndemes + 1u, 0u)),
+    cursors(std::vector<size_t>(2u * ndemes, 0u)),
+    places(std::vector<std::pair<std::uint32_t, std::uint32_t> >()),
+    broods(std::vector<Store>(ndemes, Store(arch.nwords, pool.get()))),
+    plans(std::vector<std::vector<Seed> >(ndemes)),
+    lots(std::vector<size_t>(ndemes + 1u, 0u)),
+    parcels(std::vector<Store>()),
+    yields(std::vector<double>(ndemes, 1.0)),
+    tabulated(false),
+    growths(std::vector<double>()),
+    survivals(std::vector<double>()),
+    rickers(std::vector<double>()),
+    stamps(std::vector<size_t>()),
+    stamp(0u),
+    crowding(std::vector<double>()),
+    means(std::vector<double>()),
+    counts(std::vector<size_t>()),
+    newcounts(std::vector<size_t>()),
+    offsets(std::vector<size_t>(1u, 0u)),
+    lookup(std::unordered_map<std::uint64_t, size_t>()),
+    diversity(gen::Diversity(arch.nwords))
 {
 
     // pars: parameter set
     // arch: genetic architecture
 
+    // Note: the key of the random number streams used during the life cycle
+    // is drawn from the main random number generator, which is itself seeded
+    // with the seed provided in the parameters.
+
     // Check
     check();
 
     // Reserve space for the population
     individuals->reserve(popsize);
-    newborns->reserve(0u);
-
-    // Check
-    assert(individuals->capacity() == popsize);
-    assert(newborns->capacity() == 0u);
-
-    // Create a shared pointer the genetic architecture
-    auto pointarch = std::make_shared<Architecture>(arch);
+    newborns->reserve(popsize);
 
-    // Fill the population with individuals
+    // Create the individuals
     for (size_t i = 0u; i < popsize; ++i) 
-        individuals->emplace_back(Individual(pars.allfreq, pointarch));
+        newborns->push(Individual(pars.allfreq, architecture));
+
+    // Fill the population with them (adding their genomes to the pool if needed)
+    individuals->append(*newborns);
+    newborns->clear();
 
     // Check
     assert(individuals->size() == popsize);
@@ -63,32 +98,43 @@ Population::Population(const Parameters &pars, const Architecture &arch) :
     // Sow individuals at random if needed
     if (pars.sow) shuffle();
 
+    // Gather identical individuals into classes if needed
+    if (cohorts) { condense(); return; }
+
+    // Otherwise sort them by deme and patch
+    bucket(individuals.get(), 1u);
+
+    // Make them the population (and let go of the unsorted ones)
+    std::swap(individuals, newborns);
+    newborns->release();
+    newborns->clear();
+
 }
 
 // Function to sow individuals at random across demes
 void Population::shuffle() {
 
     // Prepare a random deme sampler
-    auto pickDeme = rnd::random(0u, ndemes - 1u);
+    auto pickDeme = rnd::Random(0u, ndemes - 1u);
 
     // Check
     assert(!individuals->empty());
 
     // For each individual...
-    for (Individual& ind : *individuals) {
+    for (size_t i = 0u; i < individuals->size(); ++i) {
 
         // Sample a deme 
         const size_t newdeme = pickDeme(rnd::rng);
 
         // Prepare a patch sampler based on good patch cover
-        auto pickPatch = rnd::bernoulli(pgood[newdeme]);
+        auto pickPatch = rnd::Bernoulli(pgood[newdeme]);
 
         // Sample a patch
         const size_t newpatch = pickPatch(rnd::rng);
 
         // Update the individual
-        ind.setDeme(newdeme);
-        ind.setPatch(newpatch);
+        individuals->demes[i] = newdeme;
+        individuals->patches[i] = newpatch;
 
     }
 }
@@ -155,35 +201,141 @@ void Population::update() {
 // Function to reset population statistics
 void Population::reset() {
 
-    // Reset
+    // Reset (keeping the memory allocated)
     popsize = 0u;
-    demesizes = std::vector<size_t>(ndemes, 0u);
-    patchsizes = std::vector<size_t>(2u * ndemes, 0u);
-    meantol = std::vector<double>(2u * ndemes, 0.0);
+    nalleles = 0u;
+    demesizes.assign(ndemes, 0u);
+    patchsizes.assign(2u * ndemes, 0u);
+    meantol.assign(2u * ndemes, 0.0);
+
+    // Start a new survey of the loci that vary if needed
+    if (pruning) diversity.reset();
     
 }
 
 // Function to gather individual statistics
-void Population::gather(const size_t &deme, const size_t &patch, const double &tol) {
+void Population::gather(const size_t &deme, const size_t &patch, const double &tol, const size_t &n) {
 
     // deme: the deme of the individual
     // patch: its patch
     // tol: its tolerance value
+    // n: number of identical individuals
 
     // Patch identifier
     const size_t j = 2u * deme + patch;
 
     // Update population size
-    ++popsize;
+    popsize += n;
     
     // Update local density in the deme
-    ++demesizes[deme];
+    demesizes[deme] += n;
 
     // Update local density in the patch in the deme
-    ++patchsizes[j];
+    patchsizes[j] += n;
 
     // Update mean trait in the patch in the deme
-    meantol[j] += tol;
+    meantol[j] += n * tol;
+
+}
+
+// Function to gather statistics over the whole population
+void Population::survey() {
+
+    // Note: this is only needed with cohorts, as individuals otherwise have
+    // their statistics gathered as they join the population.
+
+    // Reset statistics
+    reset();
+
+    // Adults (read-only, their genomes may be shared)
+    const Store &adults = *individuals;
+
+    // Scratch space in case genomes cannot be read in place
+    gen::word *scratch = gen::scratch(gen::COPY, architecture.nwords);
+
+    // For each individual (or class of identical individuals)...
+    for (size_t i = 0u; i < adults.size(); ++i) {
+
+        // Gather its statistics
+        gather(adults.demes[i], adults.patches[i], adults.tolerances[i], cohorts ? counts[i] : 1u);
+
+        // Add its genome to the survey of the loci that vary if needed
+        if (pruning) diversity.add(adults.read(i, scratch));
+
+        // Count its alleles 1 if needed
+        if (sparse) nalleles += adults.ones(i);
+
+    }
+}
+
+// Function to place individuals into buckets by deme and patch
+void Population::bucket(const Store *stores, const size_t &n) {
+
+    // stores: stores holding the individuals to place
+    // n: number of stores
+
+    // Note: this is a counting sort. Individuals are added to the newborns in
+    // order of deme, then patch, keeping the order they had within each
+    // (deme, patch) bucket, and where each bucket starts is recorded. The
+    // statistics of the next generation are gathered on the way, so they are
+    // known before it even starts.
+
+    // Check
+    assert(newborns->empty());
+
+    // Reset statistics
+    reset();
+
+    // Prepare to count the individuals in each bucket
+    buckets.assign(2u * ndemes + 1u, 0u);
+
+    // Count them (shifted by one to then sum them up)
+    for (size_t s = 0u; s < n; ++s)
+        for (size_t k = 0u; k < stores[s].size(); ++k)
+            ++buckets[2u * stores[s].demes[k] + stores[s].patches[k] + 1u];
+
+    // Compute where each bucket starts
+    std::partial_sum(buckets.begin(), buckets.end(), buckets.begin());
+
+    // Positions left to fill in each bucket
+    std::copy(buckets.begin(), buckets.end() - 1u, cursors.begin());
+
+    // Record where each individual goes
+    utl::reserve(places, buckets.back());
+    places.resize(buckets.back());
+    for (size_t s = 0u; s < n; ++s)
+        for (size_t k = 0u; k < stores[s].size(); ++k)
+            places[cursors[2u * stores[s].demes[k] + stores[s].patches[k]]++] = {s, k};
+
+    // Prepare space to welcome them
+    newborns->reserve(places.size());
+
+    // Scratch space in case genomes cannot be read in place
+    gen::word *scratch = gen::scratch(gen::COPY, architecture.nwords);
+
+    // For each individual, in bucket order...
+    for (const auto &[s, k] : places) {
+
+        // Add it
+        newborns->take(stores[s], k);
+
+        // Gather its statistics
+        gather(stores[s].demes[k], stores[s].patches[k], stores[s].tolerances[k]);
+
+        // Index of the individual added
+        const size_t i = newborns->size() - 1u;
+
+        // Add its genome to the survey of the loci that vary if needed
+        if (pruning) diversity.add(newborns->read(i, scratch));
+
+        // Count its alleles 1 if needed
+        if (sparse) nalleles += newborns->ones(i);
+
+    }
+
+    // Check
+    assert(newborns->size() == buckets.back());
+    assert(popsize == buckets.back());
 
 }
 
@@ -227,6 +379,8 @@ void Population::check() const {
     assert(dispersal <= 1.0);
     assert(mutation >= 0.0);
     assert(mutation <= 1.0);
+    assert(sampler != Mutator::AUTO);
+    assert(sampler < Mutator::NSAMPLERS);
     assert(tradeoff >= 0.0);
     assert(nonlinear > 0.0);
     assert(selfing >= 0.0);
@@ -236,9 +390,15 @@ void Population::check() const {
     assert(minrealk > 0.0);
     assert(tend != 0u);
     assert(tsave != 0u);
+    assert(nthreads != 0u);
+    assert(engine < 3u);
+    assert(!cohorts || pool);
     assert(demesizes.size() == ndemes);
     assert(patchsizes.size() == 2u * ndemes);
     assert(meantol.size() == 2u * ndemes);
+    assert(buckets.size() == 2u * ndemes + 1u);
+    assert(cursors.size() == 2u * ndemes);
+    assert(broods.size() == ndemes);
     assert(time >= 0);
 
 }
@@ -320,227 +480,1181 @@ double pop::survival(const double &x, const double &theta, const double &a) {
 
 }
 
-// Function to perform one step of the life cycle
-void Population::cycle(Printer &print) {
+// Function to prepare lookup tables for the current generation
+void Population::tabulate() {
 
-    // print: a printer
+    // Note: when all loci have the same effect size, the trait value can only
+    // take as many values as there are loci, plus one. Growth rates, fitness
+    // values and survival probabilities can then be computed once per class
+    // and looked up, instead of being computed for every plant and seed. The
+    // tables are rebuilt every generation, as climate change may have changed
+    // stress levels and carrying capacities in the meantime.
 
-    // Make sure the population is not extinct
-    assert(!individuals->empty());
+    // Number of classes
+    const size_t nclasses = architecture.nloci + 1u;
 
-    // Reset statistics
-    reset();
+    // Only use tables if effect sizes are the same and classes are not too
+    // many for the plants to look up (otherwise filling them costs more than
+    // it saves)
+    tabulated = architecture.uniform && ndemes * nclasses <= popsize;
 
-    // Flag to know if it is time to save some data
-    const bool tts = print.ison() && time % tsave == 0u;
+    // Skip if not
+    if (!tabulated) return;
 
-    // Save time step if needed
-    if (tts) print.save("time", time);
+    // Size the tables
+    growths.resize(nclasses);
+    survivals.resize(2u * nclasses);
+    rickers.resize(2u * ndemes * nclasses);
+    stamps.resize(2u * ndemes * nclasses, 0u);
+
+    // Forget the fitness values of the previous generation
+    ++stamp;
+
+    // Note: fitness values are only valid if stamped with the current
+    // generation, so the table does not have to be wiped.
+
+    // For each class...
+    for (size_t k = 0u; k < nclasses; ++k) {
+
+        // Trait value of the class
+        const double x = k * architecture.effects[0u];
+
+        // Growth rate
+        growths[k] = pop::growth(x, tolmax, maxgrowth, tradeoff, nonlinear);
+
+        // Survival probability in each patch
+        survivals[k] = pop::survival(x, stress[0u], steep);
+        survivals[nclasses + k] = pop::survival(x, stress[1u], steep);
+
+    }
+
+    // Note: fitness also depends on local population sizes, and is only
+    // computed when first needed within each deme (see fecundity).
+
+}
+
+// Function to find the class of a trait value
+size_t Population::classify(const double &x) const {
+
+    // x: trait value
 
     // Check
-    assert(!individuals->empty());
+    assert(tabulated);
 
-    // For each individual...
-    for (Individual& ind : *individuals) {
+    // Number of loci carrying the one-allele
+    const size_t k = std::lround(x / architecture.effects[0u]);
 
-        // Get trait values and locations
-        const double tol = ind.getTolerance();
-        const size_t deme = ind.getDeme();
-        const size_t patch = ind.getPatch();
+    // Check
+    assert(k <= architecture.nloci);
 
-        // If needed...
-        if (tts) {
+    // Exit
+    return k;
 
-            // Save values
-            print.save("individuals", deme);
-            print.save("individuals", patch);
-            print.save("individuals", tol);
+}
 
-        }
+// Function to compute the expected number of seeds of a plant
+double Population::fecundity(const double &x, const size_t &deme, const size_t &patch) {
 
-        // Gather individual statistics
-        gather(deme, patch, tol);
+    // x: trait value
+    // deme: deme of the plant
+    // patch: patch of the plant
 
-    }
+    // Check
+    assert(deme < ndemes);
+    assert(patch < 2u);
 
-    // Verbose if needed
-    if (verbose) show();
+    // Class of the trait value if needed
+    const size_t k = tabulated ? classify(x) : 0u;
 
-    // Save population size if needed
-    if (tts) print.save("popsize", popsize);
+    // Position in the fitness table if needed
+    const size_t j = (2u * deme + patch) * (architecture.nloci + 1u) + k;
 
-    // For each patch in each deme...
-    for (size_t j = 0u; j < patchsizes.size(); ++j) {
+    // Look it up if it is there already
+    if (tabulated && stamps[j] == stamp) return rickers[j];
 
-        // Finalize the computation of the mean
-        if (patchsizes[j]) meantol[j] /= patchsizes[j];
+    // Growth rate
+    const double r = tabulated ? growths[k] : pop::growth(x, tolmax, maxgrowth, tradeoff, nonlinear);
 
-        // If needed...
-        if (tts) {
+    // Check
+    assert(!std::isnan(r));
+    assert(r <= maxgrowth);
+    assert(r >= maxgrowth - tradeoff * tolmax);
+    assert(r >= 0.0);
 
-            // Save patch size and mean trait if needed
-            print.save("patchsizes", patchsizes[j]);
-            print.save("traitmeans", meantol[j]);
+    // Total carrying capacity in the deme for the focal patch
+    const double Ktot = capacity(deme, patch);
 
-        }
+    // Current local population size
+    const size_t n = patchsizes[2u * deme + patch];
+
+    // Expected number of seeds
+    const double fitness = pop::ricker(n, r, Ktot);
+
+    // Check
+    assert(fitness >= 0.0);
+    assert(fitness <= std::exp(r));
+
+    // Remember it if needed
+    if (tabulated) { rickers[j] = fitness; stamps[j] = stamp; }
+
+    // Exit
+    return fitness;
+
+}
+
+// Function to compute the realized carrying capacity of a patch
+double Population::capacity(const size_t &deme, const size_t &patch) const {
+
+    // deme: the deme
+    // patch: the patch
+
+    // Cover of the focal patch in the deme
+    const double cover = patch ? pgood[deme] : 1.0 - pgood[deme];
+
+    // Check
+    assert(cover >= 0.0);
+    assert(cover <= 1.0);
+
+    // Total carrying capacity in the deme for the focal patch
+    double Ktot = capacities[patch] * cover;
+
+    // Clamp
+    Ktot = Ktot < minrealk ? minrealk : Ktot;
+
+    // Check
+    assert(Ktot > 0.0);
+
+    // Exit
+    return Ktot;
+
+}
+
+// Function to compute the survival probability of a seedling
+double Population::survive(const double &x, const size_t &patch) const {
+
+    // x: trait value
+    // patch: patch where the seed has landed
+
+    // Check
+    assert(patch < 2u);
+
+    // Look it up if possible
+    if (tabulated) return survivals[patch * (architecture.nloci + 1u) + classify(x)];
+
+    // Otherwise compute it
+    return pop::survival(x, stress[patch], steep);
+
+}
+
+// Function to compute the expected numbers of seeds of a whole deme at once
+void Population::sow(const size_t &d) {
+
+    // d: the deme
+
+    // Note: individuals are sorted by deme and patch, so trait values are
+    // passed to the fecundity kernel straight from the store, and crowding
+    // terms only need filling in patch by patch. Each deme works on its own
+    // stretch of the work space.
+
+    // Check
+    assert(d < ndemes);
+    assert(means.size() == popsize);
+
+    // Where the deme starts and ends
+    const size_t first = buckets[2u * d];
+    const size_t last = buckets[2u * d + 2u];
+
+    // Crowding terms of the Ricker function in each patch of the deme
+    for (size_t p = 0u; p < 2u; ++p) {
+        const double c = 1.0 - patchsizes[2u * d + p] / capacity(d, p);
+        std::fill(crowding.begin() + buckets[2u * d + p], crowding.begin() + buckets[2u * d + p + 1u], c);
     }
 
-    // Prepare to record the number of new individuals
-    size_t totseeds = 0u;
+    // Compute expected numbers of seeds
+    krn::fecundity(
+        means.data() + first, individuals->tolerances.data() + first, crowding.data() + first,
+        last - first, tolmax, maxgrowth, tradeoff, nonlinear
+    );
+
+}
+
+// First block of the stream of a plant used for its seeds (counter-based engine)
+constexpr std::uint32_t SEEDBLOCK = 1u << 31u;
+
+// Note: this leaves the first half of the stream for drawing the number of
+// seeds, so both parts can be regenerated on their own.
+
+// First block of the stream of a lot of planned seeds (see Population::build)
+constexpr std::uint32_t LOTBLOCK = SEEDBLOCK + (1u << 30u);
+
+// Note: with the counter-based engine, lots draw from the same streams as
+// plants, keyed by the index of the lot within its deme, but further down, so
+// they never overlap. With the other engines, the seed of the stream of a lot
+// is derived from that of its deme, keyed by this block as well.
+
+// Number of planned seeds built together (if batching)
+constexpr size_t LOT = 256u;
+
+// Number of seeds ahead of which the genome of a pollen donor is fetched
+constexpr size_t AHEAD = 4u;
+
+// Function to produce the seeds of the individuals of a deme
+void Population::reproduce(const size_t &d) {
+
+    // d: the deme
+
+    // Note: each deme draws from its own random number stream, derived from
+    // the seed, the time step and the deme only. Demes can therefore be
+    // processed in any order, or concurrently, with the same outcome. With
+    // the counter-based engine, each plant even has its own stream.
 
     // Check
-    assert(!individuals->empty());
+    assert(d < ndemes);
 
-    // For each individual...
-    for (Individual& ind : *individuals) {
+    // Seed of the random number stream of the deme
+    const size_t dseed = rnd::derive(seed, time, d);
 
-        // Get trait values and locations
-        const double tol = ind.getTolerance();
-        const size_t deme = ind.getDeme();
-        const size_t patch = ind.getPatch();
+    // Random number stream of the deme (generated in blocks if needed)
+    rnd::generator rng = engine == 2u ? rnd::generator(rnd::Block(dseed)) : rnd::generator(dseed);
 
-        // Compute growth rate
-        const double r = pop::growth(tol, tolmax, maxgrowth, tradeoff, nonlinear);
+    // Random number stream of the focal plant (with the counter-based engine)
+    rnd::generator own(rnd::Philox{});
 
-        // Check
-        assert(!std::isnan(r));
-        assert(r <= maxgrowth);
-        assert(r >= maxgrowth - tradeoff * tolmax);
-        assert(r >= 0.0);
+    // Newborns of the deme
+    Store &brood = broods[d];
 
-        // Cover of the focal patch in the deme
-        const double cover = patch ? pgood[deme] : 1.0 - pgood[deme];
+    // Check
+    assert(brood.empty());
 
-        // Check
-        assert(cover >= 0.0);
-        assert(cover <= 1.0);
+    // Prepare to record the number of new individuals
+    size_t totseeds = 0u;
 
-        // Total carrying capacity in the deme for the focal patch
-        double Ktot = capacities[patch] * cover;
+    // Compute expected numbers of seeds in one go if needed
+    if (vectorize) sow(d);
 
-        // Clamp
-        Ktot = Ktot < minrealk ? minrealk : Ktot;
+    // For each individual in the deme...
+    for (size_t i = buckets[2u * d]; i < buckets[2u * d + 2u]; ++i) {
 
-        // Check
-        assert(Ktot > 0.0);
+        // Get trait values and locations
+        const double tol = individuals->tolerances[i];
+        const size_t deme = individuals->demes[i];
+        const size_t patch = individuals->patches[i];
 
-        // Current local population size
-        const size_t n = patchsizes[2u * deme + patch];
+        // Check
+        assert(deme == d);
 
         // Expected number of seeds
-        const double fitness = pop::ricker(n, r, Ktot);
+        const double fitness = vectorize ? means[i] : fecundity(tol, deme, patch);
 
         // Check
         assert(fitness >= 0.0);
-        assert(fitness <= std::exp(r));
+
+        // Stream to draw from
+        rnd::generator &draw = stream(own, rng, d, i, 0u);
 
         // Realized number of seeds
-        const size_t nseeds = rnd::poisson(fitness)(rnd::rng);
+        const size_t nseeds = rnd::Poisson(fitness)(draw);
+
+        // Check
+        assert(nseeds <= UINT32_MAX);
 
         // Record the number of seeds that will be produced
-        ind.setNSeeds(nseeds);
+        individuals->nseeds[i] = nseeds;
 
         // Cumulative sum
         totseeds += nseeds;
 
     }
 
-    // Prepare space to welcome newborns
-    newborns->reserve(totseeds);
+    // Plan of the seeds of the deme (if batching)
+    std::vector<Seed> &plan = plans[d];
+
+    // Check
+    assert(plan.empty());
+
+    // Make room for every seed of the deme (with room to spare)
+    if (batching) utl::reserve(plan, totseeds);
+
+    // Note: with batching, only the fates of the seeds (including their pollen
+    // donors) are drawn here, and the seeds are built later on from the plan
+    // (see Population::build).
+
+    // Expected number of survivors, based on the previous generation
+    const size_t expected = batching ? 0u : std::ceil(totseeds * yields[d]);
+
+    // Prepare space to welcome them
+    brood.reserve(expected);
+
+    // Note: only survivors make it into the brood, so there is no need to
+    // make room for every seed. The brood grows if the estimate falls short.
 
     // Check
     assert(popsize == individuals->size());
     assert(ndemes == pgood.size());
 
-    // Prepare a partner sampler for outcrossing
-    auto getPollen = rnd::random(0u, popsize - 1u - (popsize > 1u));
+    // Prepare to sample mutations across all the seeds of the deme
+    Mutator mutator(mutation, architecture, rng, sampler, pruning ? &diversity : nullptr);
+
+    // Prepare samplers for outcrossing and dispersal
+    const rnd::Bernoulli isOutcrossed(1.0 - selfing);
+    const rnd::Bernoulli isDispersed(dispersal);
+
+    // For each adult plant in the deme...
+    for (size_t i = buckets[2u * d]; i < buckets[2u * d + 2u]; ++i) {
+
+        // Stream to draw from
+        rnd::generator &draw = stream(own, rng, d, i, SEEDBLOCK);
+
+        // Plants with their own stream start their own sequence of mutations
+        if (engine == 1u && !batching) mutator.restart(draw);
+
+        // Split its seeds into groups if needed
+        if (splitting) {
+
+            // Handle seeds group by group
+            split(brood, i, mutator, draw);
+
+            // Move on to the next plant
+            continue;
+
+        }
+
+        // Otherwise, for each seed produced...
+        for (size_t j = 0u; j < individuals->nseeds[i]; ++j) {
+
+            // Is the seed the product of outcrossing?
+            const bool outcross = isOutcrossed(draw);
+
+            // Deme where the seed lands
+            size_t seeddeme = d;
+
+            // Disperse the seed to another site if needed
+            if (ndemes > 1u && isDispersed(draw)) seeddeme = disperse(d, draw);
+
+            // Sample landing patch based on good patch cover
+            const size_t seedpatch = rnd::Bernoulli(pgood[seeddeme])(draw);
+
+            // Select another adult to provide pollen if outcrossed
+            const size_t k = outcross ? donate(i, draw) : i;
+
+            // Build the seed and keep it if it survives (unless batching)
+            if (!batching) { develop(brood, i, k, seeddeme, seedpatch, mutator, draw); continue; }
+
+            // Otherwise add it to the plan
+            plan.push_back({
+                static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(k),
+                static_cast<std::uint32_t>(seeddeme), static_cast<std::uint8_t>(seedpatch)
+            });
+        }
+    }
+
+    // Record the proportion of seeds that made it, for the next generation
+    if (totseeds > 0u && !batching) yields[d] = static_cast<double>(brood.size()) / totseeds;
+
+}
+
+// Function to pick the random number stream of a plant
+rnd::generator& Population::stream(
+    rnd::generator &own, rnd::generator &shared, const size_t &d,
+    const size_t &i, const std::uint32_t &block
+) const {
+
+    // own: where to set up the stream of the plant if needed
+    // shared: stream of the deme
+    // d: the deme
+    // i: index of the plant
+    // block: where to start within the stream of the plant
+
+    // Unless counter-based, all plants of a deme share its stream
+    if (engine != 1u) return shared;
+
+    // Otherwise the plant has its own counter-based stream
+    rnd::Philox philox(seed, time, d, i);
+
+    // Jump to the right place
+    philox.seek(block);
+
+    // Set it up
+    own = rnd::generator(philox);
+
+    // Exit
+    return own;
+
+}
+
+// Function to sample a new deme for a dispersing seed
+size_t Population::disperse(const size_t &d, rnd::generator &rng) const {
+
+    // d: the deme of origin
+    // rng: random number generator
+
+    // Check
+    assert(ndemes > 1u);
+    assert(d < ndemes);
+
+    // Sample destination deme (among all but the current one)
+    size_t newdeme = rnd::Random(0u, ndemes - 2u)(rng);
+
+    // Avoid the current deme
+    newdeme = newdeme + (newdeme >= d);
+
+    // Check
+    assert(newdeme != d);
+    assert(newdeme < ndemes);
+
+    // Exit
+    return newdeme;
+
+}
+
+// Function to sample a pollen donor for an outcrossed seed
+size_t Population::donate(const size_t &i, rnd::generator &rng) const {
+
+    // i: index of the mother plant
+    // rng: random number generator
+
+    // Select another adult at random
+    size_t k = rnd::Random(0u, popsize - 1u - (popsize > 1u))(rng);
+
+    // Avoid selfing
+    k = k + (k >= i);
+
+    // Check
+    assert(k != i);
+
+    // Exit
+    return k;
+
+}
+
+// Function to build a seed and add it to the brood if it survives
+void Population::develop(
+    Store &brood, const size_t &i, const size_t &k, const size_t &seeddeme,
+    const size_t &seedpatch, Mutator &mutator, rnd::generator &rng
+) const {
+
+    // brood: where to add the seedling
+    // i: index of the mother plant
+    // k: index of the pollen donor (the mother itself if selfed)
+    // seeddeme: deme where the seed has landed
+    // seedpatch: patch where the seed has landed
+    // mutator: mutation sampler of the deme
+    // rng: random number generator
+
+    // Check
+    assert(seeddeme < ndemes);
+    assert(seedpatch < 2u);
+
+    // Adults (read-only, their genomes may be shared)
+    const Store &adults = *individuals;
+
+    // Scratch space where the seed is put together before it is committed
+    gen::word *genome = gen::scratch(gen::SEED, architecture.nwords);
+
+    // Copy the mother into it
+    adults.load(i, genome);
+    double xseed = individuals->tolerances[i];
+
+    // If the seed is the product of outcrossing...
+    if (k != i) {
+
+        // Scratch space in case the genome of the donor cannot be read in place
+        gen::word *pollen = gen::scratch(gen::POLLEN, architecture.nwords);
+
+        // Recombine the genomes of the two parents (unless known to be identical)
+        if (!pool || adults.handles[k] != adults.handles[i])
+            gen::recombine(genome, xseed, adults.read(k, pollen), recombination, architecture, rng, pruning ? &diversity : nullptr);
+
+        // Note: pooled genomes are all distinct, so parents with the same
+        // handle have the same genome, and recombining would change nothing.
+
+    }
+
+    // Does the seed mutate?
+    mutator.mutate(genome, xseed, rng);
+
+    // Note: the seeds of the deme are treated as one long genome, so
+    // most seeds are skipped without drawing any random number.
+
+    // Check
+    assert(xseed >= 0.0);
+
+    // Compute the survival probability of the seedling
+    const double prob = survive(xseed, seedpatch);
+
+    // Check
+    assert(prob >= 0.0);
+    assert(prob <= 1.0);
+
+    // Exit if the seedling dies
+    if (!rnd::Bernoulli(prob)(rng)) return;
+
+    // Share the genome of the mother if pooled and identical
+    if (pool && std::equal(genome, genome + architecture.nwords, adults.genome(i))) {
+        brood.inherit(xseed, seeddeme, seedpatch, 0u, *individuals, i);
+        return;
+    }
+
+    // Otherwise commit the seedling to the brood with its own genome
+    brood.push(xseed, seeddeme, seedpatch, 0u, genome);
+
+}
+
+// Function to build a lot of planned seeds
+void Population::build(const size_t &c) {
+
+    // c: index of the lot
+
+    // Note: the seeds of each deme are built in lots of consecutive seeds of
+    // its plan. Each lot draws from its own stream, from the engine in use,
+    // and adds its survivors to its own store, so lots can be built in any
+    // order, or concurrently, with the same outcome. Stores are then merged
+    // in order of lots (see Population::bucket).
+
+    // Check
+    assert(c < lots.back());
+
+    // Deme whose plan the lot belongs to (the last one starting at or before it)
+    const size_t d = std::upper_bound(lots.begin(), lots.end(), c) - lots.begin() - 1u;
+
+    // Check
+    assert(d < ndemes);
+
+    // Index of the lot within the deme
+    const size_t l = c - lots[d];
+
+    // Planned seeds of the lot
+    const Seed *first = plans[d].data() + l * LOT;
+    const size_t n = std::min(LOT, plans[d].size() - l * LOT);
+
+    // Seed of the random number stream of the lot (with per-deme engines)
+    const size_t lseed = rnd::derive(rnd::derive(seed, time, d), LOTBLOCK, l);
+
+    // Counter-based stream of the lot (with the counter-based engine)
+    rnd::Philox philox(seed, time, d, l);
+    philox.seek(LOTBLOCK);
+
+    // Random number stream of the lot, from the engine in use
+    rnd::generator rng = engine == 1u ? rnd::generator(philox) :
+        engine == 2u ? rnd::generator(rnd::Block(lseed)) : rnd::generator(lseed);
+
+    // Prepare to sample mutations across the seeds of the lot
+    Mutator mutator(mutation, architecture, rng, sampler, pruning ? &diversity : nullptr);
+
+    // Where to put the seedlings
+    Store &brood = parcels[c];
+
+    // Check
+    assert(brood.empty());
+
+    // Note: donors are spread all over the population, so reading their
+    // genomes would mostly miss the cache. Asking for them a few seeds
+    // ahead lets the memory work while the seeds before are being built.
+
+    // Fetch the first donors
+    for (size_t b = 0u; b < std::min(AHEAD, n); ++b)
+        if (first[b].donor != first[b].mother) individuals->prefetch(first[b].donor);
+
+    // For each seed...
+    for (size_t b = 0u; b < n; ++b) {
+
+        // Fetch the donor of a seed further down the lot
+        if (b + AHEAD < n && first[b + AHEAD].donor != first[b + AHEAD].mother)
+            individuals->prefetch(first[b + AHEAD].donor);
+
+        // Fate of the seed
+        const Seed &s = first[b];
+
+        // Build it and keep it if it survives
+        develop(brood, s.mother, s.donor, s.deme, s.patch, mutator, rng);
+
+    }
+}
+
+// Function to handle the seeds of a plant in groups
+void Population::split(Store &brood, const size_t &i, Mutator &mutator, rnd::generator &rng) const {
+
+    // brood: where to add the seedlings
+    // i: index of the mother plant
+    // mutator: mutation sampler of the deme
+    // rng: random number generator
+
+    // Note: instead of drawing the fate of each seed in turn, the seeds are
+    // split into selfed and outcrossed, dispersing and staying, and landing in
+    // either patch, using one binomial draw per split. Selfed seeds that stay
+    // and do not mutate are clones of their mother with the same survival
+    // probability, so how many of them survive is drawn all at once.
+
+    // Number of seeds, deme and trait value of the mother
+    const size_t n = individuals->nseeds[i];
+    const size_t d = individuals->demes[i];
+    const double tol = individuals->tolerances[i];
+
+    // Number of outcrossed and selfed seeds
+    const size_t nout = rnd::Binomial(n, 1.0 - selfing)(rng);
+    const size_t nself = n - nout;
+
+    // Numbers of those that disperse
+    const size_t noutgo = ndemes > 1u ? rnd::Binomial(nout, dispersal)(rng) : 0u;
+    const size_t nselfgo = ndemes > 1u ? rnd::Binomial(nself, dispersal)(rng) : 0u;
+
+    // For each seed that has to be built one by one...
+    for (size_t j = 0u; j < nout + nselfgo; ++j) {
+
+        // Is it outcrossed?
+        const bool outcross = j < nout;
+
+        // Does it disperse?
+        const bool go = outcross ? j < noutgo : true;
+
+        // Deme where the seed lands
+        const size_t seeddeme = go ? disperse(d, rng) : d;
+
+        // Sample landing patch based on good patch cover
+        const size_t seedpatch = rnd::Bernoulli(pgood[seeddeme])(rng);
+
+        // Select another adult to provide pollen if outcrossed
+        const size_t k = outcross ? donate(i, rng) : i;
+
+        // Build the seed and keep it if it survives
+        develop(brood, i, k, seeddeme, seedpatch, mutator, rng);
+
+    }
+
+    // Number of selfed seeds staying in the deme
+    const size_t nstay = nself - nselfgo;
+
+    // Number of those landing in the good patch
+    const size_t ngood = rnd::Binomial(nstay, pgood[d])(rng);
+
+    // For each patch...
+    for (size_t p = 0u; p < 2u; ++p) {
+
+        // Number of selfed seeds landing there
+        size_t m = p ? ngood : nstay - ngood;
+
+        // Survival probability of a clone of the mother there
+        const double prob = survive(tol, p);
+
+        // Check
+        assert(prob >= 0.0);
+        assert(prob <= 1.0);
+
+        // Until all those seeds have been handled...
+        while (m > 0u) {
+
+            // Number of seeds before the next mutation
+            const size_t k = mutator.skip(m);
+
+            // Number of those unmutated clones that survive
+            const size_t nsurv = rnd::Binomial(k, prob)(rng);
+
+            // Add the survivors to the brood (sharing the genome if pooled)
+            for (size_t j = 0u; j < nsurv; ++j)
+                brood.inherit(tol, d, p, 0u, *individuals, i);
+
+            // Update counter
+            m -= k;
+
+            // Exit if done
+            if (m == 0u) break;
+
+            // Otherwise build the next seed (it mutates unless the mutator
+            // samples genomes one by one, see Mutator::skip)
+            develop(brood, i, i, d, p, mutator, rng);
 
-    // Prepare a deme sampler for seed dispersal
-    auto getDestination = rnd::random(0u, ndemes - 1u - (ndemes > 1u));
+            // Update counter
+            --m;
 
-    // Note: we set those distributions this way to avoid self.
+        }
+    }
+}
+
+// Function to find the class of an individual
+size_t Population::locate(const size_t &i) const {
+
+    // i: index of the individual
+
+    // Without cohorts, each individual stands on its own
+    if (!cohorts) return i;
+
+    // Check
+    assert(i < offsets.back());
+
+    // Find the last class starting at or before the individual
+    return std::upper_bound(offsets.begin(), offsets.end(), i) - offsets.begin() - 1u;
+
+}
+
+// Function to add newborns to their class
+void Population::settle(
+    const size_t &h, const double &tol, const size_t &deme,
+    const size_t &patch, const size_t &n
+) {
+
+    // h: handle of their genome in the pool
+    // tol: their trait value
+    // deme: their deme
+    // patch: their patch
+    // n: number of newborns
+
+    // Check
+    assert(cohorts);
+    assert(deme < ndemes);
+    assert(patch < 2u);
+
+    // Nothing to do if there are none
+    if (n == 0u) return;
+
+    // Key of the class
+    const std::uint64_t key = (static_cast<std::uint64_t>(h) * ndemes + deme) * 2u + patch;
+
+    // Find the class, or make room for a new one
+    const auto [it, added] = lookup.try_emplace(key, newborns->size());
+
+    // If the class is new...
+    if (added) {
+
+        // Add it (holding a reference to its genome)
+        pool->acquire(h);
+        newborns->share(tol, deme, patch, 0u, h);
+        newcounts.push_back(0u);
+
+    }
+
+    // Add the newborns to it
+    newcounts[it->second] += n;
+
+}
+
+// Function to turn the classes of newborns into the adult classes
+void Population::renew() {
+
+    // Newborns become adults
+    std::swap(individuals, newborns);
+    std::swap(counts, newcounts);
+
+    // Adults die (giving their genomes back to the pool)
+    newborns->release();
+    newborns->clear();
+    newcounts.clear();
+    lookup.clear();
 
-    // For each adult plant...
+    // Count the plants before each class
+    offsets.resize(counts.size() + 1u);
+    offsets[0u] = 0u;
+    for (size_t c = 0u; c < counts.size(); ++c) offsets[c + 1u] = offsets[c] + counts[c];
+
+    // Check
+    assert(counts.size() == individuals->size());
+    assert(newborns->empty());
+
+}
+
+// Function to gather identical individuals into classes
+void Population::condense() {
+
+    // Check
+    assert(cohorts);
+    assert(newborns->empty());
+    assert(lookup.empty());
+
+    // Add each individual to its class
     for (size_t i = 0u; i < individuals->size(); ++i) {
+        settle(
+            individuals->handles[i], individuals->tolerances[i],
+            individuals->demes[i], individuals->patches[i], 1u
+        );
+    }
 
-        // Isolate focal individual
-        Individual& ind = (*individuals)[i];
+    // Make the classes the population
+    renew();
 
-        // For each seed produced...
-        for (size_t j = 0u; j < ind.getNSeeds(); ++j) {
+}
 
-            // Add a clone of the parent to the population
-            newborns->push_back(ind);
+// Function to build a seed of a class and add it to the newborns if it survives
+void Population::conceive(
+    const size_t &c, const bool &outcross, const size_t &deme,
+    const size_t &patch, Mutator &mutator, rnd::generator &rng
+) {
 
-            // If the seed is the product of outcrossing...
-            if (rnd::bernoulli(1.0 - selfing)(rnd::rng)) {
+    // c: the mother class
+    // outcross: whether the seed is the product of outcrossing
+    // deme: deme where the seed has landed
+    // patch: patch where the seed has landed
+    // mutator: mutation sampler
+    // rng: random number generator
 
-                // Select another adult at random to provide pollen
-                size_t k = getPollen(rnd::rng);
+    // Check
+    assert(deme < ndemes);
+    assert(patch < 2u);
 
-                // Avoid selfing
-                k = k + (k >= i);
+    // Adults (read-only, their genomes are shared)
+    const Store &adults = *individuals;
 
-                // Check
-                assert(k != i);
+    // Scratch space where the seed is put together
+    gen::word *genome = gen::scratch(gen::SEED, architecture.nwords);
 
-                // Recombine the genomes of the two parents
-                newborns->back().recombine(recombination, (*individuals)[k]);
+    // Copy the mother into it
+    std::copy_n(adults.genome(c), architecture.nwords, genome);
+    double xseed = adults.tolerances[c];
 
-            }
+    // If the seed is the product of outcrossing (and there is another plant)...
+    if (outcross && popsize > 1u) {
 
-            // Disperse the seed to another site if needed...
-            if (ndemes > 1u && rnd::bernoulli(dispersal)(rnd::rng)) {
+        // Select another plant at random to provide pollen
+        size_t r = rnd::Random(0u, popsize - 2u)(rng);
 
-                // Sample destination deme
-                size_t newdeme = getDestination(rnd::rng);
+        // Avoid selfing (the mother being the first plant of her class)
+        r = r + (r >= offsets[c]);
 
-                // Avoid the current deme
-                newdeme = newdeme + (newdeme >= newborns->back().getDeme());
-                
-                // Check
-                assert(newdeme != newborns->back().getDeme());
+        // Class of the pollen donor
+        const size_t k = locate(r);
 
-                // Send the seed there
-                newborns->back().setDeme(newdeme);
+        // Recombine the genomes of the two parents (unless identical)
+        if (adults.handles[k] != adults.handles[c])
+            gen::recombine(genome, xseed, adults.genome(k), recombination, architecture, rng, pruning ? &diversity : nullptr);
 
-            }
+    }
+
+    // Does the seed mutate?
+    mutator.mutate(genome, xseed, rng);
+
+    // Check
+    assert(xseed >= 0.0);
+
+    // Compute the survival probability of the seedling
+    const double prob = survive(xseed, patch);
+
+    // Exit if the seedling dies
+    if (!rnd::Bernoulli(prob)(rng)) return;
+
+    // Find its genome in the pool (or add it)
+    const size_t h = pool->intern(genome);
+
+    // Add the seedling to its class
+    settle(h, xseed, deme, patch, 1u);
 
-            // Prepare to sample landing patch based on good patch cover
-            auto pickPatch = rnd::bernoulli(pgood[newborns->back().getDeme()]);
+    // Let go of the reference taken when interning (the class holds its own)
+    pool->release(h);
 
-            // Set the patch of the seed
-            newborns->back().setPatch(pickPatch(rnd::rng));
+}
+
+// Function to handle the selfed seeds of a class landing in a given deme
+void Population::scatter(
+    const size_t &c, const size_t &deme, const size_t &n,
+    Mutator &mutator, rnd::generator &rng
+) {
+
+    // c: the mother class
+    // deme: deme where the seeds land
+    // n: number of seeds
+    // mutator: mutation sampler
+    // rng: random number generator
 
-            // Does the seed mutate?
-            newborns->back().mutate(mutation);
+    // Check
+    assert(deme < ndemes);
+
+    // Nothing to do if there are no seeds
+    if (n == 0u) return;
 
-            // Check
-            newborns->back().check(ndemes);
+    // Genome and trait value of the mother class
+    const size_t h = individuals->handles[c];
+    const double tol = individuals->tolerances[c];
 
-            // Patch where the seed has landed
-            const size_t seedpatch = newborns->back().getPatch();
+    // Number of seeds landing in the good patch
+    const size_t ngood = rnd::Binomial(n, pgood[deme])(rng);
+
+    // For each patch...
+    for (size_t p = 0u; p < 2u; ++p) {
 
-            // Trait value of the seedling
-            const double xseed = newborns->back().getTolerance();
+        // Number of seeds landing there
+        size_t m = p ? ngood : n - ngood;
 
-            // Compute the survival probability of the seedling
-            const double prob = pop::survival(xseed, stress[seedpatch], steep);
+        // Survival probability of a clone of the mother there
+        const double prob = survive(tol, p);
 
-            // Check
-            assert(prob >= 0.0);
-            assert(prob <= 1.0);
+        // Until all those seeds have been handled...
+        while (m > 0u) {
 
-            // Remove the seedling if it does not survive
-            if (!rnd::bernoulli(prob)(rnd::rng)) newborns->pop_back();
+            // Number of seeds before the next mutation
+            const size_t k = mutator.skip(m);
+
+            // Those unmutated clones that survive join the class of their genome
+            settle(h, tol, deme, p, rnd::Binomial(k, prob)(rng));
+
+            // Update counter
+            m -= k;
+
+            // Exit if done
+            if (m == 0u) break;
+
+            // Otherwise build the next seed on its own (see Population::split)
+            conceive(c, false, deme, p, mutator, rng);
+
+            // Update counter
+            --m;
+
+        }
+    }
+}
+
+// Function to produce the next generation class by class
+void Population::breed() {
+
+    // Note: all the plants of a class have the same expected number of seeds,
+    // so the total number of seeds of the class is a single Poisson draw. It
+    // is split into outcrossed and selfed seeds, and those into dispersing
+    // and staying seeds, with binomial draws. Outcrossed seeds each have their
+    // own pollen donor and are built one by one. Selfed seeds are shared among
+    // demes with a multinomial draw, and among patches with a binomial draw.
+    // Those that do not mutate are clones of their mother class, and how many
+    // of them survive is drawn all at once. Classes of newborns are keyed by
+    // genome, deme and patch, so identical newborns end up in the same class.
+
+    // Check
+    assert(cohorts);
+    assert(pool);
+    assert(popsize == offsets.back());
+    assert(newborns->empty());
+
+    // Seed of the random number stream of the generation
+    const size_t gseed = rnd::derive(seed, time, 0u);
+
+    // Random number stream (generated in blocks if needed)
+    rnd::generator rng = engine == 2u ? rnd::generator(rnd::Block(gseed)) : rnd::generator(gseed);
+
+    // Note: classes are processed one after the other, from a single stream,
+    // as they all add their newborns to the same classes.
+
+    // Prepare to sample mutations across all the seeds
+    Mutator mutator(mutation, architecture, rng, sampler, pruning ? &diversity : nullptr);
+
+    // Prepare a dispersal sampler
+    const rnd::Bernoulli isDispersed(dispersal);
+
+    // For each class...
+    for (size_t c = 0u; c < individuals->size(); ++c) {
+
+        // Get trait values and locations
+        const double tol = individuals->tolerances[c];
+        const size_t deme = individuals->demes[c];
+        const size_t patch = individuals->patches[c];
+
+        // Expected number of seeds of the whole class
+        const double mean = counts[c] * fecundity(tol, deme, patch);
+
+        // Check
+        assert(mean >= 0.0);
+
+        // Realized number of seeds
+        const size_t nseeds = rnd::Poisson(mean)(rng);
+
+        // Numbers of outcrossed and selfed seeds
+        const size_t nout = rnd::Binomial(nseeds, 1.0 - selfing)(rng);
+        const size_t nself = nseeds - nout;
+
+        // For each outcrossed seed...
+        for (size_t j = 0u; j < nout; ++j) {
+
+            // Deme where the seed lands
+            size_t seeddeme = deme;
+
+            // Disperse the seed to another site if needed
+            if (ndemes > 1u && isDispersed(rng)) seeddeme = disperse(deme, rng);
+
+            // Sample landing patch based on good patch cover
+            const size_t seedpatch = rnd::Bernoulli(pgood[seeddeme])(rng);
+
+            // Build the seed and keep it if it survives
+            conceive(c, true, seeddeme, seedpatch, mutator, rng);
+
+        }
+
+        // Number of selfed seeds that disperse
+        size_t ngo = ndemes > 1u ? rnd::Binomial(nself, dispersal)(rng) : 0u;
+
+        // Handle those that stay
+        scatter(c, deme, nself - ngo, mutator, rng);
+
+        // For each other deme, as long as dispersing seeds are left...
+        for (size_t k = 0u; k + 1u < ndemes && ngo > 0u; ++k) {
+
+            // Destination deme (skipping the current one)
+            const size_t e = k + (k >= deme);
+
+            // Number of seeds landing there (all other demes being equally likely)
+            const size_t n = k + 2u == ndemes ? ngo : rnd::Binomial(ngo, 1.0 / (ndemes - 1u - k))(rng);
+
+            // Handle them
+            scatter(c, e, n, mutator, rng);
+
+            // Update counter
+            ngo -= n;
 
         }
+
+        // Check
+        assert(ngo == 0u);
+
     }
 
+    // Newborns become adults
+    renew();
+
+}
+
+// Function to perform one step of the life cycle
+void Population::cycle(Printer &print) {
+
+    // print: a printer
+
+    // Make sure the population is not extinct
+    assert(!individuals->empty());
+
+    // Flag to know if it is time to save some data
+    const bool tts = print.ison() && time % tsave == 0u;
+
+    // Save time step if needed
+    if (tts) print.save("time", time);
+
+    // Gather statistics over classes of individuals if needed
+    if (cohorts) survey();
+
+    // Note: without cohorts, statistics were gathered as the individuals
+    // joined the population (see Population::bucket).
+
+    // If needed...
+    if (tts) {
+
+        // For each individual (or class of identical individuals)...
+        for (size_t i = 0u; i < individuals->size(); ++i) {
+
+            // Get trait values and locations
+            const double tol = individuals->tolerances[i];
+            const size_t deme = individuals->demes[i];
+            const size_t patch = individuals->patches[i];
+
+            // Save values (once per individual)
+            for (size_t j = 0u; j < (cohorts ? counts[i] : 1u); ++j) {
+
+                print.save("individuals", deme);
+                print.save("individuals", patch);
+                print.save("individuals", tol);
+
+            }
+        }
+    }
+
+    // Summarize the survey if needed
+    if (pruning) diversity.close(architecture);
+
+    // Verbose if needed
+    if (verbose) show();
+
+    // Save population size if needed
+    if (tts) print.save("popsize", popsize);
+
+    // Save the number of genomes in memory and the memory they take if needed
+    if (tts) print.save("genomes", getGenomes());
+    if (tts) print.save("genomebytes", getGenomeMemory());
+
+    // For each patch in each deme...
+    for (size_t j = 0u; j < patchsizes.size(); ++j) {
+
+        // Finalize the computation of the mean
+        if (patchsizes[j]) meantol[j] /= patchsizes[j];
+
+        // If needed...
+        if (tts) {
+
+            // Save patch size and mean trait if needed
+            print.save("patchsizes", patchsizes[j]);
+            print.save("traitmeans", meantol[j]);
+
+        }
+    }
+
+    // Prepare lookup tables for this generation
+    tabulate();
+
+    // With cohorts, produce the next generation class by class
+    if (cohorts) {
+
+        // Produce the classes of newborns
+        breed();
+
+        // Exit
+        return;
+
+    }
+
+    // Check
+    assert(popsize == individuals->size());
+    assert(buckets.back() == popsize);
+
+    // Size the work space of the fecundity kernel if needed (with room to spare)
+    if (vectorize) {
+
+        utl::reserve(crowding, popsize);
+        utl::reserve(means, popsize);
+        crowding.resize(popsize);
+        means.resize(popsize);
+
+    }
+
+    // Produce the seeds of each deme, possibly in parallel
+    utl::parallel(ndemes, nthreads, [this](const size_t &d) { reproduce(d); });
+
+    // With batching, the seeds were only planned, so build them if needed
+    if (batching) {
+
+        // Count the lots of planned seeds before each deme (and in total)
+        for (size_t d = 0u; d < ndemes; ++d)
+            lots[d + 1u] = lots[d] + (plans[d].size() + LOT - 1u) / LOT;
+
+        // Make sure each lot has a store to put its seedlings in
+        if (parcels.size() < lots.back()) parcels.resize(lots.back(), Store(architecture.nwords, pool.get()));
+
+        // Build the lots, possibly in parallel
+        utl::parallel(lots.back(), nthreads, [this](const size_t &c) { build(c); });
+
+        // Empty the plans for the next generation
+        for (std::vector<Seed> &plan : plans) plan.clear();
+
+    }
+
+    // Stores the newborns were put in
+    Store *stores = batching ? parcels.data() : broods.data();
+    const size_t nstores = batching ? lots.back() : broods.size();
+
+    // Prepare to count the newborns
+    size_t nborn = 0u;
+
+    // Count them
+    for (size_t s = 0u; s < nstores; ++s) nborn += stores[s].size();
+
+    // Store their genomes as lists of positions if that takes less memory
+    // (assuming they carry as many alleles 1 as their parents)
+    if (sparse) newborns->pack(
+        nalleles * sizeof(std::uint16_t) + popsize * sizeof(std::uint32_t) <
+        popsize * architecture.nwords * sizeof(gen::word)
+    );
+
+    // Sort them by deme and patch
+    bucket(stores, nstores);
+
+    // Empty the stores for the next generation
+    for (size_t s = 0u; s < nstores; ++s) stores[s].clear();
+
+    // Check
+    assert(newborns->size() == nborn);
+
     // Newborns become adults
     std::swap(individuals, newborns);
 
-    // No more newborns (adults die) 
+    // Adults die (giving their genomes back to the pool if needed)
+    newborns->release();
     newborns->clear();
 
     // Check
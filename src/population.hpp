@@ -2,15 +2,28 @@
 #define BRACHYPODE_POPULATION_HPP
 
 // This is the header for the Population class, which encapsulates
-// a vector of Individuals and makes them go through each generation
-// of the simulation.
+// a columnar store of individuals and makes them go through each generation
+// of the simulation. Individuals are kept sorted by deme, then patch, so each
+// patch of each deme is a contiguous range of the store (see
+// Population::bucket). With cohorts, each entry of the store is instead a
+// class of identical plants (same genome, deme and patch) with a number of
+// plants, and the fates of their seeds are drawn per class (see
+// Population::breed).
 
 #include "printer.hpp"
 #include "parameters.hpp"
 #include "architecture.hpp"
 #include "individual.hpp"
+#include "store.hpp"
+#include "pool.hpp"
+#include "genome.hpp"
+#include "mutator.hpp"
+#include "kernels.hpp"
 #include "utilities.hpp"
 
+#include <unordered_map>
+#include <utility>
+
 namespace pop {
 
     // Accessory functions
@@ -43,21 +56,34 @@ public:
     bool extinct() const { return individuals->empty(); };
 
     // Function to return the population size
-    size_t size() const { return individuals->size(); };
+    size_t size() const { return cohorts ? offsets.back() : individuals->size(); };
     
     // Other getters
     size_t getTime() const { return time; };
     double getPGood(const size_t &i) const { assert(i < pgood.size()); return pgood[i]; };
     double getStress(const size_t &i) const { assert(i < stress.size()); return stress[i]; };
     double getCapacity(const size_t &i) const { assert(i < capacities.size()); return capacities[i]; };
-    size_t getDeme(const size_t &i) const { assert(i < individuals->size()); return (*individuals)[i].getDeme(); };
-    size_t getPatch(const size_t &i) const { assert(i < individuals->size()); return (*individuals)[i].getPatch(); };
+    size_t getDeme(const size_t &i) const { assert(i < size()); return individuals->demes[locate(i)]; };
+    size_t getPatch(const size_t &i) const { assert(i < size()); return individuals->patches[locate(i)]; };
+    double getTolerance(const size_t &i) const { assert(i < size()); return individuals->tolerances[locate(i)]; };
+    size_t getClasses() const { return individuals->size(); };
+    size_t getGenomes() const { return pool ? pool->unique() : individuals->size(); };
+    size_t getGenomeMemory() const { return pool ? pool->memory() : individuals->memory(); };
+    bool getTabulated() const { return tabulated; };
+    size_t getPolymorphic() const { assert(pruning); return diversity.polymorphic(); };
+    size_t getLots() const { return lots.back(); };
 
 private:
 
+    // Shared genomes (if pooled)
+    std::unique_ptr<Pool> pool;
+
     // The individuals
-    std::unique_ptr<std::vector<Individual> > individuals;
-    std::unique_ptr<std::vector<Individual> > newborns;
+    std::unique_ptr<Store> individuals;
+    std::unique_ptr<Store> newborns;
+
+    // Genetic architecture
+    Architecture architecture;
 
     // Parameters
     size_t ndemes;                     // number of demes
@@ -71,6 +97,7 @@ private:
     double steep;                      // steepness of tolerance function
     double dispersal;                  // dispersal rate
     double mutation;                   // mutation rate
+    size_t sampler;                    // mutation sampler
     double tradeoff;                   // tradeoff between tolerance and fertility
     double nonlinear;                  // non-linearity parameter for the trade-off
     double selfing;                    // rate of selfing
@@ -82,18 +109,97 @@ private:
     size_t tchange;                    // time to initiate warming
     size_t twarming;                   // duration of the warming period
     bool verbose;                      // whether to return advancement
+    bool splitting;                    // whether to split seed fates with binomial draws
+    bool vectorize;                    // whether to compute fecundities in blocks
+    bool cohorts;                      // whether to simulate classes of identical plants
+    bool pruning;                      // whether to leave out loci fixed in the population
+    bool sparse;                       // whether to store genomes as lists of positions when smaller
+    bool batching;                     // whether to plan seed fates before building the seeds
+    size_t seed;                       // seed of the random number streams
+    size_t nthreads;                   // number of threads to use
+    size_t engine;                     // random number engine (0: per deme, 1: per plant, 2: per deme in blocks)
 
     // Variables
     size_t time;
     size_t popsize;
+    size_t nalleles;
     std::vector<size_t> demesizes;
     std::vector<size_t> patchsizes;
     std::vector<double> meantol;
 
+    // Individuals grouped by patch within each deme
+    std::vector<size_t> buckets;       // where each patch of each deme starts (and where the last ends)
+    std::vector<size_t> cursors;       // next position to fill in each bucket (while sorting)
+    std::vector<std::pair<std::uint32_t, std::uint32_t> > places; // store and index of each individual in bucket order
+
+    // Newborns produced in each deme
+    std::vector<Store> broods;
+
+    // Fate of a seed, drawn before the seed is built
+    struct Seed {
+        std::uint32_t mother;          // index of the mother plant
+        std::uint32_t donor;           // index of the pollen donor (the mother if selfed)
+        std::uint32_t deme;            // deme where the seed lands
+        std::uint8_t patch;            // patch where the seed lands
+    };
+
+    // Seeds planned in each deme, to be built in lots (if batching)
+    std::vector<std::vector<Seed> > plans; // fates of the seeds of each deme
+    std::vector<size_t> lots;          // number of lots before each deme (and in total)
+    std::vector<Store> parcels;        // newborns produced by each lot
+
+    // Proportion of seeds that survived in each deme last generation
+    std::vector<double> yields;
+
+    // Lookup tables over trait value classes (if locus effects are uniform)
+    bool tabulated;                    // whether the tables are in use
+    std::vector<double> growths;       // growth rate of each class
+    std::vector<double> survivals;     // survival of each class in each patch
+    std::vector<double> rickers;       // fitness of each class in each patch of each deme
+    std::vector<size_t> stamps;        // generation each fitness value was computed in
+    size_t stamp;                      // current generation of the tables
+
+    // Work space of the fecundity kernel (in bucket order)
+    std::vector<double> crowding;      // crowding terms of the Ricker function
+    std::vector<double> means;         // expected numbers of seeds
+
+    // Classes of identical plants (with cohorts)
+    std::vector<size_t> counts;        // number of plants in each class
+    std::vector<size_t> newcounts;     // same for the classes of newborns
+    std::vector<size_t> offsets;       // number of plants before each class (and in total)
+    std::unordered_map<std::uint64_t, size_t> lookup; // class of newborns of each genome, deme and patch
+
+    // Loci that vary across the population (surveyed each generation if pruning)
+    gen::Diversity diversity;
+
     // Private setters
     void reset();
-    void gather(const size_t&, const size_t&, const double&);
+    void gather(const size_t&, const size_t&, const double&, const size_t& = 1u);
+    void survey();
+    void bucket(const Store*, const size_t&);
+    void sow(const size_t&);
+    void reproduce(const size_t&);
+    void develop(Store&, const size_t&, const size_t&, const size_t&, const size_t&, Mutator&, rnd::generator&) const;
+    void build(const size_t&);
+    void split(Store&, const size_t&, Mutator&, rnd::generator&) const;
     void shuffle();
+    void tabulate();
+    void condense();
+    void breed();
+    void conceive(const size_t&, const bool&, const size_t&, const size_t&, Mutator&, rnd::generator&);
+    void scatter(const size_t&, const size_t&, const size_t&, Mutator&, rnd::generator&);
+    void settle(const size_t&, const double&, const size_t&, const size_t&, const size_t&);
+    void renew();
+
+    // Private getters
+    size_t locate(const size_t&) const;
+    rnd::generator& stream(rnd::generator&, rnd::generator&, const size_t&, const size_t&, const std::uint32_t&) const;
+    size_t disperse(const size_t&, rnd::generator&) const;
+    size_t donate(const size_t&, rnd::generator&) const;
+    size_t classify(const double&) const;
+    double capacity(const size_t&, const size_t&) const;
+    double fecundity(const double&, const size_t&, const size_t&);
+    double survive(const double&, const size_t&) const;
 
 };
 
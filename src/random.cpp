@@ -3,5 +3,756 @@
 #include "random.hpp"
 
 // Random number generator
-std::mt19937_64 rnd::rng;
+rnd::generator rnd::rng;
 
+// Accessory function to scramble the bits of a number
+static size_t mix(size_t x) {
+
+    // x: number to scramble
+
+    // Note: this is the finalizer of the SplitMix64 generator,
+    // which maps nearby inputs to uncorrelated outputs.
+
+    // Scramble
+    x += 0x9e3779b97f4a7c15u;
+    x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9u;
+    x = (x ^ (x >> 27u)) * 0x94d049bb133111ebu;
+    
+    // Exit
+    return x ^ (x >> 31u);
+
+}
+
+// Constructor of the Philox engine
+rnd::Philox::Philox(const size_t &seed, const size_t &t, const size_t &d, const size_t &i) :
+    key({static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32u)}),
+    counter({0u, static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(d), static_cast<std::uint32_t>(t)}),
+    output(),
+    used(2u)
+{
+
+    // seed: seed of the simulation (the key)
+    // t: generation
+    // d: deme
+    // i: individual
+
+    // Check
+    assert(t <= UINT32_MAX);
+    assert(d <= UINT32_MAX);
+    assert(i <= UINT32_MAX);
+
+    // Note: each block of output holds two 64-bit numbers, and the first
+    // word of the counter numbers the blocks within the stream.
+
+}
+
+// Function to encrypt a counter with a key
+std::array<std::uint32_t, 4u> rnd::Philox::block(std::array<std::uint32_t, 4u> c, std::array<std::uint32_t, 2u> k) {
+
+    // c: counter
+    // k: key
+
+    // Constants of Philox4x32
+    constexpr std::uint64_t M0 = 0xD2511F53u;
+    constexpr std::uint64_t M1 = 0xCD9E8D57u;
+    constexpr std::uint32_t W0 = 0x9E3779B9u;
+    constexpr std::uint32_t W1 = 0xBB67AE85u;
+
+    // For each of ten rounds...
+    for (size_t r = 0u; r < 10u; ++r) {
+
+        // Bump the key (but not before the first round)
+        if (r > 0u) { k[0u] += W0; k[1u] += W1; }
+
+        // Multiply
+        const std::uint64_t p0 = M0 * c[0u];
+        const std::uint64_t p1 = M1 * c[2u];
+
+        // Mix high and low halves with the key
+        c = {
+            static_cast<std::uint32_t>(p1 >> 32u) ^ c[1u] ^ k[0u],
+            static_cast<std::uint32_t>(p1),
+            static_cast<std::uint32_t>(p0 >> 32u) ^ c[3u] ^ k[1u],
+            static_cast<std::uint32_t>(p0)
+        };
+
+    }
+
+    // Exit
+    return c;
+
+}
+
+// Function to draw a number from the Philox engine
+rnd::Philox::result_type rnd::Philox::operator()() {
+
+    // If the current block is used up...
+    if (used == 2u) {
+
+        // Check that the stream is not exhausted
+        assert(counter[0u] < UINT32_MAX);
+
+        // Encrypt the counter
+        output = block(counter, key);
+
+        // Move on to the next block
+        ++counter[0u];
+
+        // Reset
+        used = 0u;
+
+    }
+
+    // Assemble a 64-bit number from two 32-bit words
+    const result_type x = output[2u * used] | static_cast<result_type>(output[2u * used + 1u]) << 32u;
+
+    // Update
+    ++used;
+
+    // Exit
+    return x;
+
+}
+
+// Function to jump to a given block of the stream
+void rnd::Philox::seek(const std::uint32_t &b) {
+
+    // b: index of the block
+
+    // Set the counter
+    counter[0u] = b;
+
+    // Discard whatever is left of the current block
+    used = 2u;
+
+}
+
+// Constructor of the block engine
+rnd::Block::Block(const size_t &seed) :
+    state(),
+    words(),
+    used(SIZE)
+{
+
+    // seed: seed of the stream
+
+    // Note: the first lane is seeded by running SplitMix64 from the seed, as
+    // recommended for xoshiro generators. Each following lane starts where the
+    // previous one would be after 2^128 draws, so lanes never overlap.
+
+    // Polynomial to jump ahead by 2^128 draws
+    constexpr std::array<std::uint64_t, 4u> JUMP = {
+        0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu, 0xa9582618e03fc9aau, 0x39abdc4529b1661cu
+    };
+
+    // Seed the first lane
+    size_t x = seed;
+    for (size_t k = 0u; k < 4u; ++k) {
+        state[k][0u] = mix(x);
+        x += 0x9e3779b97f4a7c15u;
+    }
+
+    // Note: mix adds the SplitMix64 increment itself, so successive inputs
+    // give successive outputs of SplitMix64.
+
+    // Current state, to be jumped from lane to lane
+    std::array<std::uint64_t, 4u> s = { state[0u][0u], state[1u][0u], state[2u][0u], state[3u][0u] };
+
+    // For each other lane...
+    for (size_t l = 1u; l < LANES; ++l) {
+
+        // Prepare the jumped state
+        std::array<std::uint64_t, 4u> j = { 0u, 0u, 0u, 0u };
+
+        // For each bit of the polynomial...
+        for (size_t w = 0u; w < 4u; ++w) {
+            for (size_t b = 0u; b < 64u; ++b) {
+
+                // Accumulate the current state if needed
+                if (JUMP[w] & std::uint64_t(1u) << b)
+                    for (size_t k = 0u; k < 4u; ++k) j[k] ^= s[k];
+
+                // Step the generator
+                const std::uint64_t u = s[1u] << 17u;
+                s[2u] ^= s[0u];
+                s[3u] ^= s[1u];
+                s[1u] ^= s[2u];
+                s[0u] ^= s[3u];
+                s[2u] ^= u;
+                s[3u] = std::rotl(s[3u], 45);
+
+            }
+        }
+
+        // Set the lane
+        for (size_t k = 0u; k < 4u; ++k) state[k][l] = s[k] = j[k];
+
+    }
+}
+
+// Function to produce the next block of the block engine
+void rnd::Block::refill() {
+
+    // Note: lanes are updated in an inner loop with no dependency between
+    // iterations, which the compiler turns into vector instructions.
+
+    // Local copies of the state (one array per state word)
+    std::array<std::uint64_t, LANES> s0 = state[0u], s1 = state[1u], s2 = state[2u], s3 = state[3u];
+
+    // For each round of draws...
+    for (size_t k = 0u; k < SIZE; k += LANES) {
+
+        // For each lane...
+        for (size_t l = 0u; l < LANES; ++l) {
+
+            // Output of xoshiro256**
+            words[k + l] = std::rotl(s1[l] * 5u, 7) * 9u;
+
+            // Update the state
+            const std::uint64_t u = s1[l] << 17u;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= u;
+            s3[l] = std::rotl(s3[l], 45);
+
+        }
+    }
+
+    // Save the state
+    state = { s0, s1, s2, s3 };
+
+    // Reset
+    used = 0u;
+
+}
+
+// Function to copy out many numbers from the block engine
+void rnd::Block::fill(result_type *out, const size_t &n) {
+
+    // out: where to write
+    // n: how many numbers
+
+    // Prepare to count
+    size_t k = 0u;
+
+    // For as long as needed...
+    while (k < n) {
+
+        // Produce a new block if the current one is used up
+        if (used == SIZE) refill();
+
+        // Copy as much as possible from the current block
+        const size_t m = std::min(n - k, SIZE - used);
+        std::copy_n(words.begin() + used, m, out + k);
+
+        // Update
+        used += m;
+        k += m;
+
+    }
+}
+
+// Function to derive the seed of an independent stream
+size_t rnd::derive(const size_t &seed, const size_t &t, const size_t &i) {
+
+    // seed: seed of the simulation
+    // t: time step
+    // i: index of the stream (e.g. deme)
+
+    // Note: the same inputs always give the same seed, so a stream
+    // can be regenerated without knowing about any of the others.
+
+    // Chain the inputs through the mixing function
+    return mix(mix(mix(seed) ^ t) ^ i);
+
+}
+
+// Constructor of the Bernoulli sampler
+rnd::Bernoulli::Bernoulli(const double &p) :
+    threshold(0u),
+    always(p >= 1.0)
+{
+
+    // p: probability of success
+
+    // Check
+    assert(p >= 0.0);
+    assert(p <= 1.0);
+
+    // Note: a draw is a success if a random 64-bit integer falls below the
+    // threshold, which happens with probability threshold / 2^64.
+
+    // Nothing else to do if success is certain
+    if (always) return;
+
+    // Scale the probability to the range of the generator
+    const double t = p * 0x1.0p64;
+
+    // Set the threshold (avoiding overflow when very close to one)
+    threshold = t >= 0x1.0p64 ? UINT64_MAX : static_cast<std::uint64_t>(t);
+
+}
+
+// Function to draw many Bernoulli trials at once
+std::uint64_t rnd::Bernoulli::mask(generator &rng, const size_t &n) const {
+
+    // rng: random number generator
+    // n: number of trials (at most 64)
+
+    // Note: the outcome of trial b is bit b of the result. The same draws are
+    // used as with n successive calls to operator(), but they are read in bulk
+    // and compared with the threshold in a loop the compiler can vectorize.
+
+    // Check
+    assert(n <= 64u);
+
+    // All successes without drawing if success is certain
+    if (always) return n == 64u ? UINT64_MAX : (std::uint64_t(1u) << n) - 1u;
+
+    // Draw
+    std::array<std::uint64_t, 64u> draws;
+    rng.fill(draws.data(), n);
+
+    // Prepare the outcome
+    std::uint64_t bits = 0u;
+
+    // Compare each draw with the threshold
+    for (size_t b = 0u; b < n; ++b) bits |= std::uint64_t(draws[b] < threshold) << b;
+
+    // Exit
+    return bits;
+
+}
+
+// Constructor of the uniform integer sampler
+rnd::Random::Random(const size_t &lo, const size_t &hi) :
+    min(lo),
+    span(hi - lo + 1u)
+{
+
+    // lo: lower bound
+    // hi: upper bound
+
+    // Check
+    assert(lo <= hi);
+
+    // Note: the span wraps around to zero if all 64-bit values are allowed.
+
+}
+
+// Function to draw a uniform integer
+size_t rnd::Random::operator()(generator &rng) const {
+
+    // rng: random number generator
+
+    // Any value will do if the whole range is allowed
+    if (span == 0u) return min + rng();
+
+    // Smallest value from which the remainders are evenly spread
+    const std::uint64_t floor = (0u - span) % span;
+
+    // Note: values below that floor are rejected, so that every remainder
+    // is equally likely. This happens with probability below span / 2^64.
+
+    // For as long as it takes...
+    for (;;) {
+
+        // Draw a random integer
+        const std::uint64_t x = rng();
+
+        // Accept if above the floor
+        if (x >= floor) return min + x % span;
+
+    }
+}
+
+// Constructor of the Poisson sampler
+rnd::Poisson::Poisson(const double &mean) :
+    lambda(mean),
+    small(mean < 10.0),
+    last(0.0),
+    filled(0u),
+    slam(0.0),
+    loglam(0.0),
+    a(0.0),
+    b(0.0),
+    invalpha(0.0),
+    vr(0.0)
+{
+
+    // mean: mean of the distribution
+
+    // Check
+    assert(lambda >= 0.0);
+
+    // Note: with a small mean, the table of cumulative probabilities is
+    // only filled as far as draws require, so a sampler used for a single
+    // draw costs no more than plain inversion, and further draws reuse it.
+
+    // If the mean is small...
+    if (small) {
+
+        // Start the table with the probability of zero
+        last = std::exp(-lambda);
+        cdf[0u] = last;
+        filled = 1u;
+
+        // Exit
+        return;
+
+    }
+
+    // Otherwise prepare the constants of the transformed rejection method
+    slam = std::sqrt(lambda);
+    loglam = std::log(lambda);
+    b = 0.931 + 2.53 * slam;
+    a = -0.059 + 0.02483 * b;
+    invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    vr = 0.9277 - 3.6224 / (b - 2.0);
+
+}
+
+// Stirling approximation error log(k!) - log(sqrt(2 pi) (k + 1)^(k + 1/2) e^-(k + 1))
+static double stirling(const double &k) {
+
+    // k: value
+
+    // Exact values for small arguments
+    static const double table[10u] = {
+        0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+        0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+        0.01189670994589177, 0.01041126526197209, 0.009255462182712733,
+        0.008330563433362871
+    };
+
+    // Look up if possible
+    if (k < 10.0) return table[static_cast<size_t>(k)];
+
+    // Otherwise use the series
+    const double x = 1.0 / (k + 1.0);
+    const double x2 = x * x;
+    return (1.0 / 12.0 - (1.0 / 360.0 - 1.0 / 1260.0 * x2) * x2) * x;
+
+}
+
+// Logarithm of the factorial of a whole number (through the Stirling approximation)
+static double logfactorial(const double &k) {
+
+    // k: value
+
+    // Note: unlike std::lgamma, this does not write the sign of the result
+    // to a global variable, so it can be called from several threads at once.
+
+    // Half the logarithm of two pi
+    constexpr double HALFLOG2PI = 0.9189385332046728;
+
+    // Approximation plus its error
+    return HALFLOG2PI + (k + 0.5) * std::log(k + 1.0) - (k + 1.0) + stirling(k);
+
+}
+
+// Function to draw from the Poisson sampler
+size_t rnd::Poisson::operator()(generator &rng) const {
+
+    // rng: random number generator
+
+    // If the mean is small...
+    if (small) {
+
+        // Draw a uniform number
+        const double u = unit(rng);
+
+        // Find where it falls within the table filled so far
+        for (size_t k = 0u; k < filled; ++k) if (u < cdf[k]) return k;
+
+        // Otherwise carry on filling the table
+        while (filled < NTABLE) {
+
+            // Probability and cumulative probability of the next value
+            last *= lambda / filled;
+            cdf[filled] = cdf[filled - 1u] + last;
+
+            // Move on
+            ++filled;
+
+            // Exit if the uniform number falls there
+            if (u < cdf[filled - 1u]) return filled - 1u;
+
+        }
+
+        // Note: with a mean below ten, the table covers all but about 1e-8 of
+        // the distribution. Values further out are found by carrying on.
+
+        // Last value in the table
+        size_t k = NTABLE - 1u;
+
+        // Its probability
+        double pk = last;
+
+        // Cumulative sum
+        double sum = cdf[k];
+
+        // Carry on until the uniform number is reached (or the tail vanishes)
+        while (u >= sum && pk > 0.0) {
+
+            ++k;
+            pk *= lambda / k;
+            sum += pk;
+
+        }
+
+        // Exit
+        return k;
+
+    }
+
+    // Note: otherwise this is the PTRS algorithm (transformed rejection with
+    // squeeze) of Hormann (1993), Insurance: Mathematics and Economics 12:39-45.
+
+    // For as long as it takes...
+    for (;;) {
+
+        // Draw two uniform numbers
+        const double u = unit(rng) - 0.5;
+        const double v = unit(rng);
+
+        // Distance to the edge
+        const double us = 0.5 - std::abs(u);
+
+        // Candidate
+        const double k = std::floor((2.0 * a / us + b) * u + lambda + 0.43);
+
+        // Accept right away if within the squeeze
+        if (us >= 0.07 && v <= vr) return k;
+
+        // Reject if out of range
+        if (k < 0.0 || (us < 0.013 && v > us)) continue;
+
+        // Otherwise accept or reject based on the density
+        if (std::log(v * invalpha / (a / (us * us) + b)) <= -lambda + k * loglam - logfactorial(k))
+            return k;
+
+    }
+}
+
+// Constructor of the binomial sampler
+rnd::Binomial::Binomial(const size_t &trials, const double &prob) :
+    n(trials),
+    p(prob > 0.5 ? 1.0 - prob : prob),
+    flipped(prob > 0.5),
+    small(true),
+    m(0u),
+    q0(0.0),
+    r(0.0),
+    nr(0.0),
+    npq(0.0),
+    sqrtnpq(0.0),
+    a(0.0),
+    b(0.0),
+    c(0.0),
+    alpha(0.0),
+    vr(0.0),
+    urvr(0.0)
+{
+
+    // trials: number of trials
+    // prob: probability of success
+
+    // Check
+    assert(prob >= 0.0);
+    assert(prob <= 1.0);
+
+    // Note: if successes are more likely than failures we count failures.
+
+    // Mode
+    m = std::floor((n + 1.0) * p);
+
+    // Inversion is used if the mode is small
+    small = m < 11u;
+
+    // Probability of zero if needed
+    if (small) { q0 = std::pow(1.0 - p, static_cast<double>(n)); return; }
+
+    // Otherwise prepare the constants of BTRD
+    r = p / (1.0 - p);
+    nr = (n + 1.0) * r;
+    npq = n * p * (1.0 - p);
+    sqrtnpq = std::sqrt(npq);
+    b = 1.15 + 2.53 * sqrtnpq;
+    a = -0.0873 + 0.0248 * b + 0.01 * p;
+    c = n * p + 0.5;
+    alpha = (2.83 + 5.1 / b) * sqrtnpq;
+    vr = 0.92 - 4.2 / b;
+    urvr = 0.86 * vr;
+
+}
+
+// Function to draw from the binomial sampler
+size_t rnd::Binomial::operator()(generator &rng) const {
+
+    // rng: random number generator
+
+    // Early exit if nothing can happen
+    if (n == 0u || p == 0.0) return flipped ? n : 0u;
+
+    // Draw a number of successes (or failures if flipped)
+    size_t k = 0u;
+
+    // If the mode is small...
+    if (small) {
+
+        // Note: this is inversion, walking up the probabilities from zero.
+
+        // Constants of the recursion between consecutive probabilities
+        const double s = p / (1.0 - p);
+        const double t = (n + 1.0) * s;
+
+        // Probability of the current value
+        double pk = q0;
+
+        // Draw a uniform number
+        double u = unit(rng);
+
+        // Move on until the uniform number is used up
+        while (u > pk && k < n) {
+
+            u -= pk;
+            ++k;
+            const double next = (t / k - s) * pk;
+
+            // Stop if the probabilities vanish (rounding)
+            if (next <= 1e-16 && next < pk) break;
+
+            pk = next;
+
+        }
+
+        // Exit
+        return flipped ? n - k : k;
+
+    }
+
+    // Note: otherwise this is the BTRD algorithm (transformed rejection with
+    // decomposition) of Hormann (1993), J Stat Comput Simul 46:101-110.
+
+    // For as long as it takes...
+    for (;;) {
+
+        // Draw a uniform number
+        double v = unit(rng);
+
+        // Accept right away if within the box
+        if (v <= urvr) {
+
+            const double u = v / vr - 0.43;
+            k = std::floor((2.0 * a / (0.5 - std::abs(u)) + b) * u + c);
+            break;
+
+        }
+
+        // Otherwise sample a point
+        double u;
+        if (v >= vr) {
+
+            u = unit(rng) - 0.5;
+
+        } else {
+
+            u = v / vr - 0.93;
+            u = (u < 0.0 ? -0.5 : 0.5) - u;
+            v = unit(rng) * vr;
+
+        }
+
+        // Distance to the edge
+        const double us = 0.5 - std::abs(u);
+
+        // Candidate
+        const double x = std::floor((2.0 * a / us + b) * u + c);
+
+        // Reject if out of range
+        if (x < 0.0 || x > n) continue;
+
+        // Convert
+        k = x;
+
+        // Rescale
+        v = v * alpha / (a / (us * us) + b);
+
+        // Distance to the mode
+        const size_t km = k > m ? k - m : m - k;
+
+        // If close to the mode...
+        if (km <= 15u) {
+
+            // Compute the ratio of probabilities recursively
+            double f = 1.0;
+            if (m < k) for (size_t i = m + 1u; i <= k; ++i) f *= nr / i - r;
+            else if (m > k) for (size_t i = k + 1u; i <= m; ++i) v *= nr / i - r;
+
+            // Accept or reject
+            if (v <= f) break;
+            continue;
+
+        }
+
+        // Distance as a real number
+        const double dk = km;
+
+        // Otherwise use squeezes on the log scale
+        v = std::log(v);
+        const double rho = (dk / npq) * (((dk / 3.0 + 0.625) * dk + 1.0 / 6.0) / npq + 0.5);
+        const double t = -dk * dk / (2.0 * npq);
+        if (v < t - rho) break;
+        if (v > t + rho) continue;
+
+        // And the full density if needed
+        const double nm = n - m + 1.0;
+        const double h = (m + 0.5) * std::log((m + 1.0) / (r * nm)) + stirling(m) + stirling(n - m);
+        const double nk = n - k + 1.0;
+        if (v <= h + (n + 1.0) * std::log(nm / nk) + (k + 0.5) * std::log(nk * r / (k + 1.0)) - stirling(k) - stirling(n - k))
+            break;
+
+    }
+
+    // Exit
+    return flipped ? n - k : k;
+
+}
+
+// Constructor of the geometric sampler
+rnd::Geometric::Geometric(const double &p) :
+    scale(0.0),
+    always(p >= 1.0)
+{
+
+    // p: probability of success
+
+    // Check
+    assert(p > 0.0);
+    assert(p <= 1.0);
+
+    // Prepare the scaling factor if needed
+    if (!always) scale = 1.0 / std::log1p(-p);
+
+}
+
+// Function to draw from the geometric sampler
+size_t rnd::Geometric::operator()(generator &rng) const {
+
+    // rng: random number generator
+
+    // First trial if success is certain
+    if (always) return 0u;
+
+    // Note: this is inversion of the cumulative distribution function.
+
+    // Draw a number of failures
+    const double x = std::floor(std::log1p(-unit(rng)) * scale);
+
+    // Exit (capped to avoid overflow with tiny probabilities)
+    return x < 1e18 ? static_cast<size_t>(x) : static_cast<size_t>(1e18);
+
+}
@@ -3,7 +3,22 @@
 
 // This is the header for the namespace rnd (random). It contains aliases for
 // various kinds of probability distributions as well as a random number
-// generator.
+// generator. It also contains samplers written for the simulation loops
+// (Bernoulli, Random, Poisson, Binomial, Geometric and Exponential). They are
+// cheap to set up and to draw from. They are implemented here instead of
+// relying on the standard library, so a given stream gives the same draws
+// whichever standard library the program is built with.
+//
+// Two engines are available. The Mersenne Twister (std::mt19937_64) is a
+// sequential generator seeded with a single number. The Philox generator
+// (Philox4x32-10, Salmon et al. 2011) is counter-based: its output is a
+// function of a key and a counter, so a stream keyed by seed, generation, deme
+// and individual can be regenerated on its own, and can jump ahead at no cost.
+// The block engine runs several xoshiro256** generators (Blackman and Vigna
+// 2021) side by side and produces numbers a whole cache-sized block at a time,
+// in a loop the compiler can vectorize. Draws are then read from the block, and
+// can be copied out in bulk (see Bernoulli::mask). The type rnd::generator can
+// hold any of these engines.
 
 // Example usage:
 //
@@ -15,9 +30,32 @@
 //
 // Sample from the distribution
 // double x = mynormal(rnd::rng);
+//
+// Draw from an independent stream (e.g. one per deme and time step)
+// rnd::generator stream(rnd::derive(seed, time, deme));
+// double y = mynormal(stream);
+//
+// Draw with the in-house samplers (used the same way)
+// size_t n = rnd::Poisson(2.5)(stream);
+// bool b = rnd::Bernoulli(0.1)(stream);
+//
+// Draw from the counter-based stream of an individual
+// rnd::generator mine(rnd::Philox(seed, time, deme, individual));
+// size_t m = rnd::Poisson(2.5)(mine);
+//
+// Draw 64 Bernoulli trials at once from a block stream
+// rnd::generator fast(rnd::Block(rnd::derive(seed, time, deme)));
+// std::uint64_t bits = rnd::Bernoulli(0.1).mask(fast, 64u);
 
 #include <stddef.h>
 #include <random>
+#include <cstdint>
+#include <cmath>
+#include <array>
+#include <cassert>
+#include <variant>
+#include <bit>
+#include <algorithm>
 
 namespace rnd
 {
@@ -34,8 +72,225 @@ namespace rnd
     typedef std::gamma_distribution<double> gamma;
     typedef std::bernoulli_distribution bernoulli;
 
+    // Counter-based random number engine
+    class Philox {
+
+    public:
+
+        // Types and bounds required from a random number engine
+        typedef std::uint64_t result_type;
+        static constexpr result_type min() { return 0u; };
+        static constexpr result_type max() { return UINT64_MAX; };
+
+        // Constructor
+        Philox(const size_t& = 0u, const size_t& = 0u, const size_t& = 0u, const size_t& = 0u);
+
+        // Function to draw a number
+        result_type operator()();
+
+        // Function to jump to a given block of the stream
+        void seek(const std::uint32_t&);
+
+        // Function to encrypt a counter with a key (ten rounds)
+        static std::array<std::uint32_t, 4u> block(std::array<std::uint32_t, 4u>, std::array<std::uint32_t, 2u>);
+
+    private:
+
+        std::array<std::uint32_t, 2u> key;     // key (the seed)
+        std::array<std::uint32_t, 4u> counter; // block, individual, deme, generation
+        std::array<std::uint32_t, 4u> output;  // current block of output
+        size_t used;                           // numbers of the block already used
+
+    };
+
+    // Block random number engine (xoshiro256** lanes run side by side)
+    class Block {
+
+    public:
+
+        // Types and bounds required from a random number engine
+        typedef std::uint64_t result_type;
+        static constexpr result_type min() { return 0u; };
+        static constexpr result_type max() { return UINT64_MAX; };
+
+        // Number of generators run side by side
+        static constexpr size_t LANES = 8u;
+
+        // Number of draws per block (4 KiB)
+        static constexpr size_t SIZE = 512u;
+
+        // Constructor
+        Block(const size_t& = 0u);
+
+        // Function to draw a number
+        result_type operator()() { if (used == SIZE) refill(); return words[used++]; };
+
+        // Function to copy out many numbers at once
+        void fill(result_type*, const size_t&);
+
+    private:
+
+        // Function to produce the next block
+        void refill();
+
+        std::array<std::array<std::uint64_t, LANES>, 4u> state; // state words of each lane
+        std::array<std::uint64_t, SIZE> words;                  // current block of output
+        size_t used;                                            // draws of the block already used
+
+    };
+
+    // Random number generator (holding any of the engines)
+    class generator {
+
+    public:
+
+        // Types and bounds required from a random number engine
+        typedef std::uint64_t result_type;
+        static constexpr result_type min() { return 0u; };
+        static constexpr result_type max() { return UINT64_MAX; };
+
+        // Constructors
+        generator(const size_t &s = 5489u) : engine(std::mt19937_64(s)) {};
+        generator(const Philox &p) : engine(p) {};
+        generator(const Block &b) : engine(b) {};
+
+        // Function to draw a number
+        result_type operator()() {
+            if (std::mt19937_64 *m = std::get_if<std::mt19937_64>(&engine)) return (*m)();
+            if (Block *b = std::get_if<Block>(&engine)) return (*b)();
+            return (*std::get_if<Philox>(&engine))();
+        };
+
+        // Function to draw many numbers at once
+        void fill(result_type *out, const size_t &n) {
+            if (std::mt19937_64 *m = std::get_if<std::mt19937_64>(&engine)) { for (size_t k = 0u; k < n; ++k) out[k] = (*m)(); return; }
+            if (Block *b = std::get_if<Block>(&engine)) return b->fill(out, n);
+            Philox &p = *std::get_if<Philox>(&engine);
+            for (size_t k = 0u; k < n; ++k) out[k] = p();
+        };
+
+        // Function to reseed (with a Mersenne Twister)
+        void seed(const size_t &s) { engine = std::mt19937_64(s); };
+
+    private:
+
+        // The engine
+        std::variant<std::mt19937_64, Philox, Block> engine;
+
+    };
+
     // Random number generator
-    extern std::mt19937_64 rng;
+    extern generator rng;
+
+    // Function to derive the seed of an independent stream
+    size_t derive(const size_t&, const size_t&, const size_t&);
+
+    // Function to draw a uniform number in [0, 1) from 53 random bits
+    inline double unit(generator &rng) { return (rng() >> 11u) * 0x1.0p-53; };
+
+    // Bernoulli sampler (comparison with an integer threshold)
+    class Bernoulli {
+
+    public:
+
+        Bernoulli(const double&);
+        bool operator()(generator &rng) const { return always || rng() < threshold; };
+        std::uint64_t mask(generator&, const size_t&) const;
+
+    private:
+
+        std::uint64_t threshold; // success if a random integer falls below
+        bool always;             // success no matter what (probability one)
+
+    };
+
+    // Uniform integer sampler between two bounds (included)
+    class Random {
+
+    public:
+
+        Random(const size_t&, const size_t&);
+        size_t operator()(generator&) const;
+
+    private:
+
+        size_t min;         // lower bound
+        std::uint64_t span; // number of possible values (zero for all of them)
+
+    };
+
+    // Poisson sampler (table lookup for small means, PTRS otherwise)
+    class Poisson {
+
+    public:
+
+        Poisson(const double&);
+        size_t operator()(generator&) const;
+
+    private:
+
+        // Number of cumulative probabilities kept for small means
+        static constexpr size_t NTABLE = 32u;
+
+        double lambda;                      // mean
+        bool small;                         // whether to use the table
+        mutable std::array<double, NTABLE> cdf; // cumulative probabilities
+        mutable double last;                // probability of the last value in the table
+        mutable size_t filled;              // number of values in the table so far
+        double slam, loglam, a, b;          // constants of PTRS
+        double invalpha, vr;                // more constants of PTRS
+
+    };
+
+    // Binomial sampler (inversion for small means, BTRD otherwise)
+    class Binomial {
+
+    public:
+
+        Binomial(const size_t&, const double&);
+        size_t operator()(generator&) const;
+
+    private:
+
+        size_t n;                           // number of trials
+        double p;                           // probability (at most one half)
+        bool flipped;                       // whether p stands for failures
+        bool small;                         // whether to use inversion
+        size_t m;                           // mode
+        double q0;                          // probability of zero (inversion)
+        double r, nr, npq, sqrtnpq;         // constants of BTRD
+        double a, b, c, alpha, vr, urvr;    // more constants of BTRD
+
+    };
+
+    // Geometric sampler (number of failures before the first success)
+    class Geometric {
+
+    public:
+
+        Geometric(const double&);
+        size_t operator()(generator&) const;
+
+    private:
+
+        double scale; // one over the log of the probability of failure
+        bool always;  // success at the first trial no matter what
+
+    };
+
+    // Exponential sampler
+    class Exponential {
+
+    public:
+
+        Exponential(const double &rate) : scale(1.0 / rate) { assert(rate > 0.0); };
+        double operator()(generator &rng) const { return -std::log1p(-unit(rng)) * scale; };
+
+    private:
+
+        double scale; // mean
+
+    };
 
 }
 
@@ -104,8 +104,8 @@ bool Reader::readnext(std::istringstream &line, std::string &input) {
         // For each character...
         for (char c : input) {
 
-            // Make sure it is alphanumeric or a dot or a minus
-            if (!std::isalnum(c) && c != '.' && c != '-') error = true;
+            // Make sure it is alphanumeric or a dot or a sign
+            if (!std::isalnum(c) && c != '.' && c != '-' && c != '+') error = true;
 
             // Exit if needed
             if (error) break;
@@ -11,6 +11,9 @@
 #include <vector>
 #include <cassert>
 #include <functional>
+#include <charconv>
+#include <cmath>
+#include <type_traits>
 
 class Reader {
 
@@ -151,6 +154,42 @@ private:
     // Validity errors
     void checkerror(const std::string&) const;
 
+    // Function to parse a value from a string
+    template <typename T>
+    bool parse(const std::string &input, T &value) const {
+
+        // input: string to parse
+        // value: variable to parse into
+
+        // Note: numbers are parsed in place, without setting up a stream for
+        // each of them, which matters for lines with many values (e.g. the
+        // locations and effects of a large genetic architecture).
+
+        // Numbers (other than true or false) are parsed directly
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+
+            // Parse the whole string
+            const char *end = input.data() + input.size();
+            const auto [ptr, ec] = std::from_chars(input.data(), end, value);
+
+            // Succeed only if nothing is left over (and not infinite or NaN)
+            if constexpr (std::is_floating_point_v<T>) return ec == std::errc() && ptr == end && std::isfinite(value);
+            else return ec == std::errc() && ptr == end;
+
+        } else {
+
+            // Otherwise go through a stream
+            std::istringstream stream(input);
+
+            // Prepare to capture leftover characters
+            char leftover;
+
+            // Read the value and check
+            return (stream >> value) && !(stream >> leftover);
+
+        }
+    }
+
     // // Function to read a value from the current line
     template <typename T> 
     void read(
@@ -167,15 +206,9 @@ private:
         // Make sure the next value can be read
         if (!readnext(line, temp)) 
             throw std::runtime_error(errorReadValue());
-            
-        // Prepare to store the value
-        std::istringstream stream(temp);
-
-        // Prepare to capture leftover characters 
-        char leftover;
 
-        // Read the value and check
-        if (!(stream >> value) || (stream >> leftover))
+        // Parse the value
+        if (!parse(temp, value))
             throw std::runtime_error(errorParseValue());
 
         // Check validity
@@ -0,0 +1,537 @@
+// This script contains the functions of the Store structure.
+
+#include "store.hpp"
+
+// Constructor
+Store::Store(const size_t &n, Pool *p) :
+    nwords(n),
+    pool(p),
+    sparse(false),
+    tolerances(std::vector<double>()),
+    demes(std::vector<std::uint32_t>()),
+    patches(std::vector<std::uint8_t>()),
+    nseeds(std::vector<std::uint32_t>()),
+    genomes(std::vector<gen::word>()),
+    handles(std::vector<std::uint32_t>()),
+    positions(std::vector<std::uint16_t>()),
+    starts(std::vector<std::uint32_t>())
+{
+
+    // n: number of words per genome
+    // p: pool of genomes (if any)
+
+    // Check
+    assert(nwords > 0u);
+    assert(nwords <= gen::NWORDS);
+
+}
+
+// Function to reserve space for a number of individuals
+void Store::reserve(const size_t &n) {
+
+    // n: number of individuals
+
+    // Note: room is made with some to spare (see utl::reserve), so a store
+    // whose size goes up and down soon stops allocating memory altogether.
+
+    // Reserve space in each column
+    utl::reserve(tolerances, n);
+    utl::reserve(demes, n);
+    utl::reserve(patches, n);
+    utl::reserve(nseeds, n);
+    if (pool) utl::reserve(handles, n);
+
+    // Reserve space for the genomes (only the ends of the lists if packed)
+    if (sparse) utl::reserve(starts, n + 1u);
+    else utl::reserve(genomes, n * nwords);
+
+}
+
+// Function to remove all individuals
+void Store::clear() {
+
+    // Note: this keeps the memory allocated. References to pooled genomes are
+    // not given back (see Store::release).
+
+    // Clear each column
+    tolerances.clear();
+    demes.clear();
+    patches.clear();
+    nseeds.clear();
+    genomes.clear();
+    handles.clear();
+    positions.clear();
+
+    // Only the start of the first list is left if packed
+    starts.assign(sparse ? 1u : 0u, 0u);
+
+}
+
+// Function to choose whether genomes are stored as lists of positions
+void Store::pack(const bool &yes) {
+
+    // yes: whether to store them as lists
+
+    // Check
+    assert(empty());
+    assert(!yes || !pool);
+
+    // Give back the memory of the genomes if they are to be stored the other
+    // way (swapping with empty containers, as clearing keeps it allocated)
+    if (yes && !sparse) std::vector<gen::word>().swap(genomes);
+    if (!yes && sparse) {
+        std::vector<std::uint16_t>().swap(positions);
+        std::vector<std::uint32_t>().swap(starts);
+    }
+
+    // Switch
+    sparse = yes;
+
+    // Start over
+    clear();
+
+}
+
+// Function to add an individual at the end
+void Store::push(const Individual &ind) {
+
+    // ind: the individual to add
+
+    // Copy its attributes and genome
+    push(ind.getTolerance(), ind.getDeme(), ind.getPatch(), ind.getNSeeds(), ind.getGenome());
+
+}
+
+// Function to add an individual at the end from its attributes
+void Store::push(
+    const double &tol, const size_t &deme, const size_t &patch,
+    const size_t &n, const gen::word *alleles
+) {
+
+    // tol: trait value
+    // deme: deme
+    // patch: patch
+    // n: number of seeds
+    // alleles: words of the genome
+
+    // Check
+    assert(deme <= UINT32_MAX);
+    assert(patch < 2u);
+    assert(n <= UINT32_MAX);
+
+    // Copy the attributes
+    tolerances.push_back(tol);
+    demes.push_back(deme);
+    patches.push_back(patch);
+    nseeds.push_back(n);
+
+    // Add the genome
+    keep(alleles);
+
+    // Check
+    assert(pool || sparse || genomes.size() == size() * nwords);
+
+}
+
+// Function to add the genome of an individual (whose attributes have been added)
+void Store::keep(const gen::word *alleles) {
+
+    // alleles: words of the genome
+
+    // Point to the arena if needed
+    if (pool) handles.push_back(FRESH | genomes.size() / nwords);
+
+    // If genomes are stored as lists of positions...
+    if (sparse) {
+
+        // List the loci carrying allele 1
+        gen::encode(alleles, nwords, positions);
+
+        // Record where the list ends
+        starts.push_back(positions.size());
+
+        // Check
+        assert(positions.size() <= UINT32_MAX);
+
+        // Exit
+        return;
+
+    }
+
+    // Otherwise copy the words of the genome that are in use
+    genomes.insert(genomes.end(), alleles, alleles + nwords);
+
+}
+
+// Function to read the genome of an individual
+const gen::word* Store::read(const size_t &i, gen::word *scratch) const {
+
+    // i: index of the individual
+    // scratch: where to rebuild the genome if it cannot be read in place
+
+    // Read in place if possible
+    if (!sparse) return genome(i);
+
+    // Otherwise rebuild it from its list of positions
+    load(i, scratch);
+
+    // Exit
+    return scratch;
+
+}
+
+// Function to copy the genome of an individual
+void Store::load(const size_t &i, gen::word *alleles) const {
+
+    // i: index of the individual
+    // alleles: where to copy the words of the genome
+
+    // Copy the words if stored as words
+    if (!sparse) { std::copy_n(genome(i), nwords, alleles); return; }
+
+    // Check
+    assert(i + 1u < starts.size());
+
+    // Otherwise rebuild them from the list of positions
+    gen::decode(positions.data() + starts[i], starts[i + 1u] - starts[i], alleles, nwords);
+
+}
+
+// Function to ask for the genome of an individual to be brought into cache
+void Store::prefetch(const size_t &i) const {
+
+    // i: index of the individual
+
+    // Note: this is only a hint, and does nothing on compilers that do not
+    // support it. At most the first few cache lines of the genome are asked
+    // for, the hardware picking up the rest as it is read through.
+
+#if defined(__GNUC__) || defined(__clang__)
+
+    // Check
+    assert(i < size());
+
+    // Where the genome starts and how many bytes it takes
+    const char *first;
+    size_t nbytes;
+
+    // Read the list of positions if packed, or the words otherwise
+    if (sparse) {
+        first = reinterpret_cast<const char*>(positions.data() + starts[i]);
+        nbytes = (starts[i + 1u] - starts[i]) * sizeof(std::uint16_t);
+    } else {
+        first = reinterpret_cast<const char*>(genome(i));
+        nbytes = nwords * sizeof(gen::word);
+    }
+
+    // Ask for each cache line in turn (up to eight of them)
+    for (size_t b = 0u; b < std::min<size_t>(nbytes, 512u); b += 64u)
+        __builtin_prefetch(first + b);
+
+#else
+
+    // Nothing to do
+    (void)i;
+
+#endif
+
+}
+
+// Function to return the number of loci carrying allele 1 in an individual
+size_t Store::ones(const size_t &i) const {
+
+    // i: index of the individual
+
+    // Length of its list if packed
+    if (sparse) return starts[i + 1u] - starts[i];
+
+    // Otherwise count the bits set
+    return gen::count(genome(i), nwords);
+
+}
+
+// Function to return the memory taken by the genomes (in bytes)
+size_t Store::memory() const {
+
+    // Add up the memory taken by the containers of the genomes
+    return genomes.capacity() * sizeof(gen::word) +
+        positions.capacity() * sizeof(std::uint16_t) +
+        starts.capacity() * sizeof(std::uint32_t);
+
+}
+
+// Function to add an individual with the genome of an individual from another store
+void Store::inherit(
+    const double &tol, const size_t &deme, const size_t &patch,
+    const size_t &n, const Store &other, const size_t &i
+) {
+
+    // tol: trait value
+    // deme: deme
+    // patch: patch
+    // n: number of seeds
+    // other: the store holding the individual with the genome to inherit
+    // i: index of that individual
+
+    // Note: the genome is copied, unless both stores share the same pool and
+    // the genome is already in it, in which case the handle is shared.
+
+    // Copy the genome if needed
+    if (!pool || pool != other.pool || other.fresh(i)) {
+        gen::word *scratch = gen::scratch(gen::COPY, nwords);
+        push(tol, deme, patch, n, other.read(i, scratch));
+        return;
+    }
+
+    // Otherwise share the genome
+    share(tol, deme, patch, n, other.handles[i]);
+
+}
+
+// Function to add an individual whose genome is already in the pool
+void Store::share(
+    const double &tol, const size_t &deme, const size_t &patch,
+    const size_t &n, const size_t &h
+) {
+
+    // tol: trait value
+    // deme: deme
+    // patch: patch
+    // n: number of seeds
+    // h: handle of the genome in the pool
+
+    // Note: no reference to the genome is taken (see Store::release).
+
+    // Check
+    assert(pool);
+    assert(pool->count(h));
+    assert(deme <= UINT32_MAX);
+    assert(patch < 2u);
+    assert(n <= UINT32_MAX);
+
+    // Copy the attributes
+    tolerances.push_back(tol);
+    demes.push_back(deme);
+    patches.push_back(patch);
+    nseeds.push_back(n);
+
+    // Refer to the genome
+    handles.push_back(h);
+
+}
+
+// Function to add a copy of an individual from another store at the end
+void Store::clone(const Store &other, const size_t &i) {
+
+    // other: the store to copy from
+    // i: index of the individual to copy
+
+    // Check
+    assert(i < other.size());
+    assert(other.nwords == nwords);
+
+    // Scratch space in case the genome cannot be read in place
+    gen::word *scratch = gen::scratch(gen::COPY, nwords);
+
+    // Copy its attributes and genome
+    push(other.tolerances[i], other.demes[i], other.patches[i], other.nseeds[i], other.read(i, scratch));
+
+}
+
+// Function to add all the individuals of another store at the end
+void Store::append(const Store &other) {
+
+    // other: the store to copy from
+
+    // Check
+    assert(other.nwords == nwords);
+
+    // Copy each column in bulk
+    tolerances.insert(tolerances.end(), other.tolerances.begin(), other.tolerances.end());
+    demes.insert(demes.end(), other.demes.begin(), other.demes.end());
+    patches.insert(patches.end(), other.patches.begin(), other.patches.end());
+    nseeds.insert(nseeds.end(), other.nseeds.begin(), other.nseeds.end());
+
+    // If genomes are not pooled and stored as words in both stores...
+    if (!pool && !sparse && !other.sparse) {
+
+        // Copy them in bulk too
+        genomes.insert(genomes.end(), other.genomes.begin(), other.genomes.end());
+
+        // Check
+        assert(genomes.size() == size() * nwords);
+
+        // Exit
+        return;
+
+    }
+
+    // If they are stored as lists of positions in both stores...
+    if (sparse && other.sparse) {
+
+        // Where the lists added start
+        const size_t offset = positions.size();
+
+        // Copy the lists in bulk
+        positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+
+        // And where they end
+        for (size_t i = 1u; i < other.starts.size(); ++i) starts.push_back(offset + other.starts[i]);
+
+        // Check
+        assert(positions.size() <= UINT32_MAX);
+        assert(starts.size() == size() + 1u);
+
+        // Exit
+        return;
+
+    }
+
+    // If they are stored differently...
+    if (!pool) {
+
+        // Scratch space where to read each genome
+        gen::word *scratch = gen::scratch(gen::COPY, nwords);
+
+        // Convert them one by one
+        for (size_t i = 0u; i < other.size(); ++i) keep(other.read(i, scratch));
+
+        // Check
+        assert(!sparse || starts.size() == size() + 1u);
+        assert(sparse || genomes.size() == size() * nwords);
+
+        // Exit
+        return;
+
+    }
+
+    // Check
+    assert(other.pool == pool);
+
+    // Otherwise, for each individual added...
+    for (size_t i = 0u; i < other.size(); ++i) {
+
+        // Add its genome to the pool if fresh, or refer to it once more
+        if (other.fresh(i)) handles.push_back(pool->intern(other.genome(i)));
+        else { pool->acquire(other.handles[i]); handles.push_back(other.handles[i]); }
+
+    }
+
+    // Note: the individuals added refer to genomes in the pool only, so they
+    // own their references, which are given back by Store::release.
+
+}
+
+// Function to add an individual of another store at the end
+void Store::take(const Store &other, const size_t &i) {
+
+    // other: the store to copy from
+    // i: index of the individual to copy
+
+    // Note: this does for a single individual what Store::append does for all
+    // of them, so individuals can be added in any order.
+
+    // Check
+    assert(i < other.size());
+    assert(other.nwords == nwords);
+
+    // Copy the attributes
+    tolerances.push_back(other.tolerances[i]);
+    demes.push_back(other.demes[i]);
+    patches.push_back(other.patches[i]);
+    nseeds.push_back(other.nseeds[i]);
+
+    // If genomes are not pooled and stored as words in both stores...
+    if (!pool && !sparse && !other.sparse) {
+
+        // Copy the words of the genome
+        const auto from = other.genomes.begin() + i * nwords;
+        genomes.insert(genomes.end(), from, from + nwords);
+
+        // Exit
+        return;
+
+    }
+
+    // If they are stored as lists of positions in both stores...
+    if (sparse && other.sparse) {
+
+        // Copy the list
+        positions.insert(positions.end(), other.positions.begin() + other.starts[i], other.positions.begin() + other.starts[i + 1u]);
+
+        // And where it ends
+        starts.push_back(positions.size());
+
+        // Check
+        assert(positions.size() <= UINT32_MAX);
+
+        // Exit
+        return;
+
+    }
+
+    // If they are stored differently...
+    if (!pool) {
+
+        // Scratch space where to read the genome
+        gen::word *scratch = gen::scratch(gen::COPY, nwords);
+
+        // Convert it
+        keep(other.read(i, scratch));
+
+        // Exit
+        return;
+
+    }
+
+    // Check
+    assert(other.pool == pool);
+
+    // Otherwise add its genome to the pool if fresh, or refer to it once more
+    if (other.fresh(i)) handles.push_back(pool->intern(other.genome(i)));
+    else { pool->acquire(other.handles[i]); handles.push_back(other.handles[i]); }
+
+    // Note: as with Store::append, the individual added owns its reference.
+
+}
+
+// Function to give back the references held to pooled genomes
+void Store::release() {
+
+    // Nothing to do if genomes are not pooled
+    if (!pool) return;
+
+    // Give back every reference to a genome in the pool
+    for (const std::uint32_t &h : handles) if (!(h & FRESH)) pool->release(h);
+
+}
+
+// Function to remove the last individual
+void Store::pop() {
+
+    // Check
+    assert(!empty());
+
+    // Index of the last individual
+    const size_t i = size() - 1u;
+
+    // Remove its list of positions if packed
+    if (sparse) { positions.resize(starts[i]); starts.pop_back(); }
+
+    // Or remove its genome if it sits at the end of the arena
+    else if (fresh(i) && (slot(i) + 1u) * nwords == genomes.size())
+        genomes.resize(genomes.size() - nwords);
+
+    // Note: a reference to a pooled genome is not given back here.
+
+    // Remove its attributes
+    tolerances.pop_back();
+    demes.pop_back();
+    patches.pop_back();
+    nseeds.pop_back();
+    if (pool) handles.pop_back();
+
+    // Check
+    assert(pool || sparse || genomes.size() == size() * nwords);
+
+}
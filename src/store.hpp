@@ -0,0 +1,116 @@
+#ifndef BRACHYPODE_STORE_HPP
+#define BRACHYPODE_STORE_HPP
+
+// This is the header for the Store structure, a columnar container of individuals.
+// Instead of keeping a vector of Individual objects, a Store keeps one contiguous
+// vector per attribute (trait value, deme, patch, number of seeds), and packs all
+// genomes next to each other into a single vector of words (the genome arena),
+// each genome taking a fixed number of words. Loops that only need a few
+// attributes then only stream through those, and copying an individual amounts
+// to copying a handful of values and a block of genome words. Each genome takes
+// as many words as needed by the genetic architecture, and no more.
+//
+// A Store can also keep its genomes in a shared Pool instead, in which case
+// each individual holds a handle to its genome. Newborns either share the
+// genome of their mother (when they are an exact copy of it) or bring a fresh
+// genome along in the arena of the store, which is added to the pool when
+// they join the population (see Store::append). A pooled store does not own
+// the references it holds unless it got them from Store::append, and gives
+// them back with Store::release.
+//
+// A Store that is not pooled can also keep each genome as a list of the
+// positions of the loci carrying allele 1, all lists being packed next to each
+// other (see Store::pack). This takes less memory than the words of the genome
+// when allele 1 is rare. Such genomes cannot be accessed in place, and are
+// read into words instead (see Store::read).
+
+#include "individual.hpp"
+#include "genome.hpp"
+#include "pool.hpp"
+#include "utilities.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+struct Store {
+
+    // Constructor
+    Store(const size_t&, Pool* = nullptr);
+
+    // Setters
+    void reserve(const size_t&);
+    void clear();
+    void push(const Individual&);
+    void push(const double&, const size_t&, const size_t&, const size_t&, const gen::word*);
+    void inherit(const double&, const size_t&, const size_t&, const size_t&, const Store&, const size_t&);
+    void share(const double&, const size_t&, const size_t&, const size_t&, const size_t&);
+    void clone(const Store&, const size_t&);
+    void append(const Store&);
+    void take(const Store&, const size_t&);
+    void release();
+    void pop();
+    void pack(const bool&);
+
+    // Function to return the number of individuals
+    size_t size() const { return tolerances.size(); };
+
+    // Function to tell whether the store is empty
+    bool empty() const { return tolerances.empty(); };
+
+    // Function to tell whether genomes are kept in a pool
+    bool pooled() const { return pool != nullptr; };
+
+    // Function to tell whether an individual has its genome in the arena
+    bool fresh(const size_t &i) const { assert(i < size()); return !pool || handles[i] & FRESH; };
+
+    // Functions to access the genome of an individual in place (unless packed)
+    gen::word* genome(const size_t &i) { assert(!sparse); assert(fresh(i)); return genomes.data() + slot(i) * nwords; };
+    const gen::word* genome(const size_t &i) const { assert(!sparse); return fresh(i) ? genomes.data() + slot(i) * nwords : pool->genome(handles[i]); };
+
+    // Functions to read the genome of an individual, however it is stored
+    const gen::word* read(const size_t&, gen::word*) const;
+    void load(const size_t&, gen::word*) const;
+
+    // Function to ask for the genome of an individual to be brought into cache
+    void prefetch(const size_t&) const;
+
+    // Function to return the number of loci carrying allele 1 in an individual
+    size_t ones(const size_t&) const;
+
+    // Function to return the memory taken by the genomes (in bytes)
+    size_t memory() const;
+
+    // Marker of the handles of genomes kept in the arena (pooled stores only)
+    static constexpr std::uint32_t FRESH = 1u << 31u;
+
+    // Number of words per genome
+    size_t nwords;
+
+    // Pool of genomes (if any)
+    Pool *pool;
+
+    // Whether genomes are stored as lists of positions
+    bool sparse;
+
+    // Columns
+    std::vector<double> tolerances;        // trait values
+    std::vector<std::uint32_t> demes;      // demes
+    std::vector<std::uint8_t> patches;     // patches
+    std::vector<std::uint32_t> nseeds;     // numbers of seeds
+    std::vector<gen::word> genomes;        // genome arena
+    std::vector<std::uint32_t> handles;    // handles to genomes (pooled stores only)
+    std::vector<std::uint16_t> positions;  // positions of alleles 1 (sparse stores only)
+    std::vector<std::uint32_t> starts;     // where the positions of each genome start, and end (same)
+
+private:
+
+    // Function to add the genome of an individual
+    void keep(const gen::word*);
+
+    // Function to locate the genome of an individual in the arena
+    size_t slot(const size_t &i) const { return pool ? handles[i] & ~FRESH : i; };
+
+};
+
+#endif
@@ -7,12 +7,83 @@
 #include <cmath>
 #include <cassert>
 #include <vector>
+#include <thread>
+#include <atomic>
 
 namespace utl {
 
     // Function to compute the power of a number
     double power(const double&, const double&);
 
+    // Function to make room in a vector, with some to spare
+    template <typename T>
+    void reserve(std::vector<T> &v, const size_t &n) {
+
+        // v: the vector
+        // n: number of elements it must be able to hold
+
+        // Note: when more room is needed, half as much again is taken, so a
+        // vector whose size goes up and down around some value soon stops
+        // being reallocated.
+
+        if (n > v.capacity()) v.reserve(n + n / 2u);
+
+    }
+
+    // Function to run a task on every index of a range using several threads
+    template <typename F>
+    void parallel(const size_t &n, const size_t &nthreads, const F &task) {
+
+        // n: number of indices (e.g. demes) to process
+        // nthreads: number of threads to use
+        // task: function to call on each index
+
+        // Note: the indices are handed out one at a time to whichever
+        // thread is free, so the task must not depend on the order in
+        // which indices are processed, or on which thread runs them.
+
+        // Check
+        assert(nthreads > 0u);
+
+        // Number of threads actually needed
+        const size_t m = nthreads < n ? nthreads : n;
+
+        // If only one thread is needed...
+        if (m <= 1u) {
+
+            // Run everything on the current thread
+            for (size_t i = 0u; i < n; ++i) task(i);
+
+            // Exit
+            return;
+
+        }
+
+        // Next index to be processed
+        std::atomic<size_t> next(0u);
+
+        // Work to be done by each thread
+        auto work = [&]() {
+
+            // Take the next index for as long as there are some left
+            for (size_t i = next++; i < n; i = next++) task(i);
+
+        };
+
+        // Prepare the extra threads
+        std::vector<std::thread> threads;
+        threads.reserve(m - 1u);
+
+        // Launch them
+        for (size_t j = 1u; j < m; ++j) threads.emplace_back(work);
+
+        // The current thread works too
+        work();
+
+        // Wait for all threads to finish
+        for (std::thread &thread : threads) thread.join();
+
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
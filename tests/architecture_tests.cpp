@@ -36,6 +36,34 @@ BOOST_AUTO_TEST_CASE(architectureHasRightAttributes) {
     BOOST_CHECK_EQUAL(arch.effects[1u], 0.1);
     BOOST_CHECK_EQUAL(arch.effects[2u], 0.1);
 
+    // Check genome width
+    BOOST_CHECK_EQUAL(arch.nwords, 1u);
+
+    // Check that all effect sizes are the same
+    BOOST_CHECK(arch.uniform);
+
+}
+
+// Check that genomes are just wide enough for the number of loci
+BOOST_AUTO_TEST_CASE(architectureGenomeWidth) {
+
+    // Parameters
+    Parameters pars;
+
+    // For various numbers of loci...
+    for (size_t nloci : {1u, 64u, 65u, 128u, 500u, 1000u}) {
+
+        // Set the number of loci
+        pars.nloci = nloci;
+
+        // Create an architecture
+        Architecture arch(pars);
+
+        // Check that there are enough words but no spare one
+        BOOST_CHECK(arch.nwords * 64u >= nloci);
+        BOOST_CHECK((arch.nwords - 1u) * 64u < nloci);
+
+    }
 }
 
 // Same for a loaded architecture
@@ -69,11 +97,83 @@ BOOST_AUTO_TEST_CASE(loadedArchitectureHasRightAttributes) {
     BOOST_CHECK_EQUAL(arch.effects[2u], 0.2);
     BOOST_CHECK_EQUAL(arch.effects[3u], 0.1);
 
+    // Check that effect sizes are not all the same
+    BOOST_CHECK(!arch.uniform);
+
     // Remove files
     std::remove("architecture.txt");
 
 }
 
+// Check that a large architecture is saved and read back exactly
+BOOST_AUTO_TEST_CASE(largeArchitectureRoundTrip) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 100000u;
+    pars.effect = 0.3;
+
+    // Generate an architecture
+    Architecture arch1(pars);
+
+    // Save it
+    arch1.save("architecture.txt");
+
+    // Read it back
+    Architecture arch2(Parameters(), "architecture.txt");
+
+    // Check that nothing was lost
+    BOOST_CHECK_EQUAL(arch2.nloci, 100000u);
+    BOOST_CHECK_EQUAL(arch2.nwords, arch1.nwords);
+    BOOST_CHECK(arch2.locations == arch1.locations);
+    BOOST_CHECK(arch2.effects == arch1.effects);
+    BOOST_CHECK(arch2.uniform);
+
+    // Remove files
+    std::remove("architecture.txt");
+
+}
+
+// Check that loci are located correctly along the genome
+BOOST_AUTO_TEST_CASE(architectureLocatesLoci) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 100u;
+
+    // Create an architecture
+    Architecture arch(pars);
+
+    // Prepare a position sampler
+    auto getPosition = rnd::uniform(0.0, 1.0);
+
+    // For many positions...
+    for (size_t i = 0u; i < 1000u; ++i) {
+
+        // Sample a position
+        const double x = getPosition(rnd::rng);
+
+        // Count the loci lying at or before it the slow way
+        const size_t expected = std::upper_bound(arch.locations.begin(), arch.locations.end(), x) - arch.locations.begin();
+
+        // Check
+        BOOST_CHECK_EQUAL(arch.locate(x), expected);
+
+    }
+
+    // Positions exactly on a locus include that locus
+    BOOST_CHECK_EQUAL(arch.locate(arch.locations[10u]), 11u);
+
+    // Positions at the ends
+    BOOST_CHECK_EQUAL(arch.locate(0.0), 0u);
+    BOOST_CHECK_EQUAL(arch.locate(1.0), 100u);
+
+}
+
 // Test that error if the parameter is no architecture parameter
 BOOST_AUTO_TEST_CASE(errorWhenUnknownParameter) {
 
@@ -97,7 +197,7 @@ BOOST_AUTO_TEST_CASE(errorWhenInvalidNLoci) {
 
     // Check error
     tst::checkError([&] { Architecture arch(Parameters(), "a1.txt"); }, "Too many values for parameter nloci in line 1 of file a1.txt");
-    tst::checkError([&] { Architecture arch(Parameters(), "a2.txt"); }, "Parameter nloci must be between 1 and 1000 in line 1 of file a2.txt");
+    tst::checkError([&] { Architecture arch(Parameters(), "a2.txt"); }, "Parameter nloci must be between 1 and 100000 in line 1 of file a2.txt");
 
     // Remove files
     std::remove("a1.txt");
@@ -19,14 +19,35 @@ BOOST_AUTO_TEST_CASE(isProportion) {
 
 }
 
-// Test the one-to-thousand checking function
-BOOST_AUTO_TEST_CASE(isOneToThousand) {
+// Test the one-to-hundred-thousand checking function
+BOOST_AUTO_TEST_CASE(isOneToHundredThousand) {
 
     // Known values
-    BOOST_CHECK_EQUAL(chk::onetothousand(0u), "must be between 1 and 1000");
-    BOOST_CHECK_EQUAL(chk::onetothousand(1u), "");
-    BOOST_CHECK_EQUAL(chk::onetothousand(1000u), "");
-    BOOST_CHECK_EQUAL(chk::onetothousand(1001u), "must be between 1 and 1000");
+    BOOST_CHECK_EQUAL(chk::onetohundredthousand(0u), "must be between 1 and 100000");
+    BOOST_CHECK_EQUAL(chk::onetohundredthousand(1u), "");
+    BOOST_CHECK_EQUAL(chk::onetohundredthousand(100000u), "");
+    BOOST_CHECK_EQUAL(chk::onetohundredthousand(100001u), "must be between 1 and 100000");
+
+}
+
+// Test the random number engine checking function
+BOOST_AUTO_TEST_CASE(isEngine) {
+
+    // Known values
+    BOOST_CHECK_EQUAL(chk::engine(0u), "");
+    BOOST_CHECK_EQUAL(chk::engine(1u), "");
+    BOOST_CHECK_EQUAL(chk::engine(2u), "");
+    BOOST_CHECK_EQUAL(chk::engine(3u), "must be 0, 1 or 2");
+
+}
+
+// Test the mutation sampler checking function
+BOOST_AUTO_TEST_CASE(isSampler) {
+
+    // Known values
+    BOOST_CHECK_EQUAL(chk::sampler(0u), "");
+    BOOST_CHECK_EQUAL(chk::sampler(4u), "");
+    BOOST_CHECK_EQUAL(chk::sampler(5u), "must be 0, 1, 2, 3 or 4");
 
 }
 
@@ -0,0 +1,508 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests that have to do with the gen namespace.
+
+#include "../src/genome.hpp"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+// Test that bits can be toggled and read across words
+BOOST_AUTO_TEST_CASE(genomeBitsToggle) {
+
+    // Empty genome
+    std::array<gen::word, gen::NWORDS> alleles = {};
+
+    // Set bits on both sides of a word boundary
+    gen::toggle(alleles.data(), 63u);
+    gen::toggle(alleles.data(), 64u);
+    gen::toggle(alleles.data(), 999u);
+
+    // Check
+    BOOST_CHECK(gen::test(alleles.data(), 63u));
+    BOOST_CHECK(gen::test(alleles.data(), 64u));
+    BOOST_CHECK(gen::test(alleles.data(), 999u));
+    BOOST_CHECK(!gen::test(alleles.data(), 0u));
+    BOOST_CHECK_EQUAL(gen::count(alleles.data(), gen::NWORDS), 3u);
+
+    // Toggle one back
+    gen::toggle(alleles.data(), 64u);
+
+    // Check
+    BOOST_CHECK(!gen::test(alleles.data(), 64u));
+    BOOST_CHECK_EQUAL(gen::count(alleles.data(), gen::NWORDS), 2u);
+
+}
+
+// Test that a range of bits can be set
+BOOST_AUTO_TEST_CASE(genomeFillRange) {
+
+    // For various ranges...
+    for (auto [from, to] : std::vector<std::pair<size_t, size_t> >{{0u, 0u}, {3u, 9u}, {0u, 64u}, {60u, 70u}, {5u, 1000u}, {63u, 64u}, {64u, 65u}}) {
+
+        // Empty genome
+        std::array<gen::word, gen::NWORDS> mask = {};
+
+        // Set the range
+        gen::fill(mask.data(), from, to);
+
+        // Check every bit
+        for (size_t i = 0u; i < gen::NWORDS * gen::WORDBITS; ++i)
+            BOOST_CHECK_EQUAL(gen::test(mask.data(), i), i >= from && i < to);
+
+    }
+}
+
+// Test that flipping alleles updates the trait value
+BOOST_AUTO_TEST_CASE(genomeFlipUpdatesTrait) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 100u;
+    pars.effect = 0.5;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Empty genome
+    std::array<gen::word, gen::NWORDS> alleles = {};
+
+    // Trait value
+    double x = 0.0;
+
+    // Flip a few loci
+    gen::flip(alleles.data(), x, 0u, arch);
+    gen::flip(alleles.data(), x, 70u, arch);
+
+    // Check
+    BOOST_CHECK_EQUAL(x, 1.0);
+
+    // Flip one back
+    gen::flip(alleles.data(), x, 70u, arch);
+
+    // Check
+    BOOST_CHECK_EQUAL(x, 0.5);
+
+    // Flip everything
+    gen::flipall(alleles.data(), x, arch);
+
+    // Check
+    BOOST_CHECK_EQUAL(gen::count(alleles.data(), gen::NWORDS), 99u);
+    BOOST_CHECK_CLOSE(x, 49.5, 1E-6);
+
+}
+
+// Test that each thread has its own scratch genomes, one per use
+BOOST_AUTO_TEST_CASE(genomeScratchPerThread) {
+
+    // Borrow space for a seed and for a pollen donor
+    gen::word *seed = gen::scratch(gen::SEED, 10u);
+    gen::word *pollen = gen::scratch(gen::POLLEN, 10u);
+
+    // Check that they are apart
+    BOOST_CHECK(seed != pollen);
+
+    // Check that the same space is lent again when it is large enough
+    seed[9u] = 42u;
+    BOOST_CHECK(gen::scratch(gen::SEED, 5u) == seed);
+    BOOST_CHECK_EQUAL(gen::scratch(gen::SEED, 10u)[9u], 42u);
+
+    // Borrow space for a seed on another thread
+    gen::word *other = nullptr;
+    std::thread thread([&]() { other = gen::scratch(gen::SEED, 10u); });
+    thread.join();
+
+    // Check that it was not the same
+    BOOST_CHECK(other != nullptr);
+    BOOST_CHECK(other != seed);
+
+}
+
+// Test that recombining with an identical genome changes nothing
+BOOST_AUTO_TEST_CASE(genomeRecombineWithSelf) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 200u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Genome with every other locus set
+    std::array<gen::word, gen::NWORDS> alleles = {};
+    double x = 0.0;
+    for (size_t i = 0u; i < pars.nloci; i += 2u) gen::flip(alleles.data(), x, i, arch);
+
+    // Copy it
+    const std::array<gen::word, gen::NWORDS> pollen = alleles;
+    const double y = x;
+
+    // Recombine with lots of crossovers
+    gen::recombine(alleles.data(), x, pollen.data(), 100.0, arch, rnd::rng);
+
+    // Check that nothing changed
+    BOOST_CHECK(alleles == pollen);
+    BOOST_CHECK_EQUAL(x, y);
+
+}
+
+// Test that recombination gives the same result as walking through loci one by one
+BOOST_AUTO_TEST_CASE(genomeRecombineMatchesLocusByLocus) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 300u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Random genomes for the mother and the pollen donor
+    std::array<gen::word, gen::NWORDS> mother = {}, pollen = {};
+    double xmother = 0.0, xpollen = 0.0;
+    for (size_t i = 0u; i < pars.nloci; ++i) {
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::flip(mother.data(), xmother, i, arch);
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::flip(pollen.data(), xpollen, i, arch);
+    }
+
+    // For various recombination rates...
+    for (double rho : {0.5, 3.0, 50.0}) {
+
+        // For many offspring...
+        for (size_t seed = 0u; seed < 100u; ++seed) {
+
+            // Offspring made by the word-based recombination
+            std::array<gen::word, gen::NWORDS> alleles = mother;
+            double x = xmother;
+            rnd::generator rng1(seed);
+            gen::recombine(alleles.data(), x, pollen.data(), rho, arch, rng1);
+
+            // Offspring made by walking through loci with the same random numbers
+            std::array<gen::word, gen::NWORDS> expected = mother;
+            double y = xmother;
+            rnd::generator rng2(seed);
+            auto getNextCrossover = rnd::Exponential(rho);
+            double crossover = getNextCrossover(rng2);
+            size_t hap = rnd::Bernoulli(0.5)(rng2);
+            size_t locus = 0u;
+            while (locus < arch.nloci) {
+                if (crossover < arch.locations[locus]) {
+                    hap = !hap;
+                    crossover += getNextCrossover(rng2);
+                } else {
+                    if (hap && gen::test(expected.data(), locus) != gen::test(pollen.data(), locus))
+                        gen::flip(expected.data(), y, locus, arch);
+                    ++locus;
+                }
+            }
+
+            // Check that both give exactly the same offspring
+            BOOST_CHECK(alleles == expected);
+
+            // Check that the trait value was evaluated from scratch if needed
+            if (alleles != mother) BOOST_CHECK_EQUAL(x, gen::evaluate(alleles.data(), arch));
+            BOOST_CHECK_CLOSE(x, y, 1e-9);
+
+        }
+    }
+}
+
+// Test that recombination and mutation work with the largest genomes
+BOOST_AUTO_TEST_CASE(genomeHandlesMaximumLoci) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = gen::MAXLOCI;
+
+    // Architecture (with equal effects)
+    Architecture arch(pars);
+
+    // Check
+    BOOST_CHECK_EQUAL(arch.nwords, gen::NWORDS);
+
+    // Random genomes for the mother and the pollen donor
+    std::array<gen::word, gen::NWORDS> mother = {}, pollen = {};
+    for (size_t i = 0u; i < pars.nloci; ++i) {
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::toggle(mother.data(), i);
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::toggle(pollen.data(), i);
+    }
+
+    // Their trait values
+    const double xmother = gen::evaluate(mother.data(), arch);
+
+    // Offspring made by recombination
+    std::array<gen::word, gen::NWORDS> alleles = mother;
+    double x = xmother;
+    rnd::generator rng1(42u);
+    gen::recombine(alleles.data(), x, pollen.data(), 20.0, arch, rng1);
+
+    // Offspring made by walking through loci with the same random numbers
+    std::array<gen::word, gen::NWORDS> expected = mother;
+    rnd::generator rng2(42u);
+    auto getNextCrossover = rnd::Exponential(20.0);
+    double crossover = getNextCrossover(rng2);
+    size_t hap = rnd::Bernoulli(0.5)(rng2);
+    for (size_t locus = 0u; locus < arch.nloci; ) {
+        if (crossover < arch.locations[locus]) {
+            hap = !hap;
+            crossover += getNextCrossover(rng2);
+        } else {
+            if (hap && gen::test(expected.data(), locus) != gen::test(pollen.data(), locus))
+                gen::toggle(expected.data(), locus);
+            ++locus;
+        }
+    }
+
+    // Check that both give the same offspring, with the exact trait value
+    BOOST_CHECK(alleles == expected);
+    BOOST_CHECK_EQUAL(x, gen::evaluate(alleles.data(), arch));
+
+    // Mutate it
+    gen::mutateGeometric(alleles.data(), x, 0.001, arch, rnd::rng);
+
+    // Check that the trait value is still exact
+    BOOST_CHECK_EQUAL(x, gen::evaluate(alleles.data(), arch));
+
+}
+
+// Test that the trait value of a whole genome is the sum of its effects
+BOOST_AUTO_TEST_CASE(genomeEvaluatesTrait) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 150u;
+    pars.effect = 0.1;
+
+    // Architecture with equal effects
+    Architecture arch(pars);
+
+    // Check
+    BOOST_CHECK(arch.uniform);
+
+    // Random genome
+    std::array<gen::word, gen::NWORDS> alleles = {};
+    for (size_t i = 0u; i < pars.nloci; ++i)
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::toggle(alleles.data(), i);
+
+    // Number of loci carrying allele 1
+    const size_t n = gen::count(alleles.data(), arch.nwords);
+
+    // Check
+    BOOST_CHECK_EQUAL(gen::evaluate(alleles.data(), arch), n * 0.1);
+
+    // Give every locus its own effect
+    for (size_t i = 0u; i < pars.nloci; ++i) arch.effects[i] = 0.01 * (i + 1u);
+    arch.uniform = false;
+
+    // Sum of the effects of the loci carrying allele 1
+    double sum = 0.0;
+    for (size_t i = 0u; i < pars.nloci; ++i)
+        if (gen::test(alleles.data(), i)) sum += arch.effects[i];
+
+    // Check
+    BOOST_CHECK_CLOSE(gen::evaluate(alleles.data(), arch), sum, 1e-9);
+
+    // An empty genome has a trait value of zero
+    std::array<gen::word, gen::NWORDS> empty = {};
+    BOOST_CHECK_EQUAL(gen::evaluate(empty.data(), arch), 0.0);
+
+}
+
+// Test that a survey finds the loci that vary across genomes
+BOOST_AUTO_TEST_CASE(genomeDiversityFindsPolymorphicLoci) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 200u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Genomes that only differ at a few loci
+    std::array<gen::word, gen::NWORDS> a = {}, b = {}, c = {};
+    gen::fill(a.data(), 0u, 10u);
+    gen::fill(b.data(), 0u, 10u);
+    gen::fill(c.data(), 0u, 10u);
+    gen::toggle(b.data(), 5u);
+    gen::toggle(c.data(), 150u);
+
+    // Survey them
+    gen::Diversity diversity(arch.nwords);
+    diversity.add(a.data());
+    diversity.add(b.data());
+    diversity.add(c.data());
+    diversity.close(arch);
+
+    // Check
+    BOOST_CHECK_EQUAL(diversity.polymorphic(), 2u);
+    BOOST_CHECK(diversity.active(0u));
+    BOOST_CHECK(!diversity.active(1u));
+    BOOST_CHECK(diversity.active(2u));
+    BOOST_CHECK(!diversity.active(3u));
+    BOOST_CHECK(diversity.words == std::vector<size_t>({0u, 2u}));
+
+    // Start over
+    diversity.reset();
+    diversity.add(a.data());
+    diversity.close(arch);
+
+    // Check that a single genome has nothing varying
+    BOOST_CHECK_EQUAL(diversity.polymorphic(), 0u);
+    BOOST_CHECK(diversity.words.empty());
+
+}
+
+// Test that leaving out fixed loci gives the same trait values
+BOOST_AUTO_TEST_CASE(genomeEvaluatesWithFixedLociLeftOut) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 300u;
+
+    // Architecture with a different effect at each locus
+    Architecture arch(pars);
+    for (size_t i = 0u; i < pars.nloci; ++i) arch.effects[i] = 0.01 * (i + 1u);
+    arch.uniform = false;
+
+    // Random genome for the mother
+    std::array<gen::word, gen::NWORDS> mother = {};
+    for (size_t i = 0u; i < pars.nloci; ++i)
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::toggle(mother.data(), i);
+
+    // Pollen donor that only differs within the second word
+    std::array<gen::word, gen::NWORDS> pollen = mother;
+    pollen[1u] = ~mother[1u];
+
+    // Survey both
+    gen::Diversity diversity(arch.nwords);
+    diversity.add(mother.data());
+    diversity.add(pollen.data());
+    diversity.close(arch);
+
+    // Check
+    BOOST_CHECK(diversity.words == std::vector<size_t>({1u}));
+
+    // Check that both evaluations agree
+    BOOST_CHECK_CLOSE(gen::evaluate(mother.data(), arch, &diversity), gen::evaluate(mother.data(), arch), 1e-9);
+
+    // For many offspring...
+    for (size_t seed = 0u; seed < 50u; ++seed) {
+
+        // Offspring recombined with and without the survey
+        std::array<gen::word, gen::NWORDS> x = mother, y = mother;
+        double tx = gen::evaluate(mother.data(), arch), ty = tx;
+        rnd::generator rng1(seed), rng2(seed);
+        gen::recombine(x.data(), tx, pollen.data(), 5.0, arch, rng1);
+        gen::recombine(y.data(), ty, pollen.data(), 5.0, arch, rng2, &diversity);
+
+        // Check that they are the same
+        BOOST_CHECK(x == y);
+        BOOST_CHECK_CLOSE(tx, ty, 1e-9);
+
+    }
+
+    // Mutate the mother at a fixed locus
+    gen::toggle(mother.data(), 250u);
+
+    // Check that the mutation is accounted for
+    BOOST_CHECK_CLOSE(gen::evaluate(mother.data(), arch, &diversity), gen::evaluate(mother.data(), arch), 1e-9);
+
+}
+
+// Test that recombination only looks at words with loci that vary
+BOOST_AUTO_TEST_CASE(genomeRecombineSkipsFixedWords) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 300u;
+
+    // Architecture (with equal effects)
+    Architecture arch(pars);
+
+    // Random genome for the mother
+    std::array<gen::word, gen::NWORDS> mother = {};
+    for (size_t i = 0u; i < pars.nloci; ++i)
+        if (rnd::bernoulli(0.5)(rnd::rng)) gen::toggle(mother.data(), i);
+
+    // Pollen donor that only differs within the second word
+    std::array<gen::word, gen::NWORDS> pollen = mother;
+    pollen[1u] = ~mother[1u];
+
+    // Survey both
+    gen::Diversity diversity(arch.nwords);
+    diversity.add(mother.data());
+    diversity.add(pollen.data());
+    diversity.close(arch);
+
+    // For many offspring...
+    for (size_t seed = 0u; seed < 50u; ++seed) {
+
+        // Offspring recombined with and without the survey
+        std::array<gen::word, gen::NWORDS> x = mother, y = mother;
+        double tx = gen::evaluate(mother.data(), arch), ty = tx;
+        rnd::generator rng1(seed), rng2(seed);
+        gen::recombine(x.data(), tx, pollen.data(), 5.0, arch, rng1);
+        gen::recombine(y.data(), ty, pollen.data(), 5.0, arch, rng2, &diversity);
+
+        // Check that they are exactly the same
+        BOOST_CHECK(x == y);
+        BOOST_CHECK_EQUAL(tx, ty);
+
+    }
+
+    // Make the donor differ in a word the survey says is fixed
+    pollen[3u] = ~mother[3u];
+
+    // Recombine with a crossover at nearly every locus
+    std::array<gen::word, gen::NWORDS> z = mother;
+    double tz = gen::evaluate(mother.data(), arch);
+    rnd::generator rng(1u);
+    gen::recombine(z.data(), tz, pollen.data(), 1000.0, arch, rng, &diversity);
+
+    // Check that the word was left out (only words that vary are looked at)
+    BOOST_CHECK_EQUAL(z[3u], mother[3u]);
+    BOOST_CHECK(z[1u] != mother[1u]);
+
+}
+
+// Test that a genome can be turned into a list of positions and back
+BOOST_AUTO_TEST_CASE(genomeEncodesPositions) {
+
+    // Number of words (enough for 1000 loci)
+    const size_t nwords = 16u;
+
+    // Genome with a few loci carrying allele 1
+    std::array<gen::word, gen::NWORDS> alleles = {};
+    for (size_t i : {0u, 63u, 64u, 500u, 999u}) gen::toggle(alleles.data(), i);
+
+    // Encode it
+    std::vector<std::uint16_t> positions = {7u};
+    gen::encode(alleles.data(), nwords, positions);
+
+    // Check that the positions were appended in order
+    BOOST_CHECK(positions == std::vector<std::uint16_t>({7u, 0u, 63u, 64u, 500u, 999u}));
+
+    // Decode it (over some garbage)
+    std::array<gen::word, gen::NWORDS> decoded;
+    decoded.fill(~gen::word(0u));
+    gen::decode(positions.data() + 1u, 5u, decoded.data(), nwords);
+
+    // Check
+    BOOST_CHECK(std::equal(alleles.begin(), alleles.begin() + nwords, decoded.begin()));
+
+}
@@ -10,7 +10,7 @@
 BOOST_AUTO_TEST_CASE(individualInitialization) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -35,7 +35,7 @@ BOOST_AUTO_TEST_CASE(individualInitializationWithAllMutations) {
     pars.nloci = 20u;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(1.0, arch);
@@ -50,7 +50,7 @@ BOOST_AUTO_TEST_CASE(individualInitializationWithAllMutations) {
 BOOST_AUTO_TEST_CASE(changeInDeme) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -67,7 +67,7 @@ BOOST_AUTO_TEST_CASE(changeInDeme) {
 BOOST_AUTO_TEST_CASE(changeInPatch) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -84,7 +84,7 @@ BOOST_AUTO_TEST_CASE(changeInPatch) {
 BOOST_AUTO_TEST_CASE(changeInNSeeds) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -101,7 +101,7 @@ BOOST_AUTO_TEST_CASE(changeInNSeeds) {
 BOOST_AUTO_TEST_CASE(changeInTrait) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -118,7 +118,7 @@ BOOST_AUTO_TEST_CASE(changeInTrait) {
 BOOST_AUTO_TEST_CASE(noMutationDoesNotChangeTheGenome) {
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(Parameters()));
+    Architecture arch = Architecture(Parameters());
 
     // Create individual
     Individual ind(0.0, arch);
@@ -127,7 +127,7 @@ BOOST_AUTO_TEST_CASE(noMutationDoesNotChangeTheGenome) {
     const size_t sum = ind.countAlleles();
 
     // Mutate with zero mutation rate
-    ind.mutate(0.0);
+    ind.mutate(0.0, arch);
 
     // Re-compute sum of alleles
     const size_t newsum = ind.countAlleles();
@@ -148,13 +148,13 @@ BOOST_AUTO_TEST_CASE(fullMutationChangesTheWholeGenome) {
     pars.effect = 0.1;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
 
     // Mutate with certainty
-    ind.mutate(1.0);
+    ind.mutate(1.0, arch);
 
     // All alleles should be one
     BOOST_CHECK_EQUAL(ind.countAlleles(), 20u);
@@ -172,16 +172,16 @@ BOOST_AUTO_TEST_CASE(differentMutationTypes) {
     Parameters pars;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
 
     // Mutate with some rate
-    BOOST_CHECK_NO_THROW(ind.mutate(0.9));
-    BOOST_CHECK_NO_THROW(ind.mutate(0.6));
-    BOOST_CHECK_NO_THROW(ind.mutate(0.05));
-    BOOST_CHECK_NO_THROW(ind.mutate(0.001));
+    BOOST_CHECK_NO_THROW(ind.mutate(0.9, arch));
+    BOOST_CHECK_NO_THROW(ind.mutate(0.6, arch));
+    BOOST_CHECK_NO_THROW(ind.mutate(0.05, arch));
+    BOOST_CHECK_NO_THROW(ind.mutate(0.001, arch));
 
 }
 
@@ -195,31 +195,31 @@ BOOST_AUTO_TEST_CASE(earlyExitInBinomialMutation) {
     pars.nloci = 10u;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
 
     // Binomial mutation with full probability
-    ind.mutateBinomial(1.0);
+    ind.mutateBinomial(1.0, arch);
 
     // Check that all alleles have been mutated
     BOOST_CHECK_EQUAL(ind.countAlleles(), 10u); 
 
     // Revert all mutations with shuffle
-    ind.mutateShuffle(1.0);
+    ind.mutateShuffle(1.0, arch);
 
     // Check
     BOOST_CHECK_EQUAL(ind.countAlleles(), 0u);
     
     // Run with zero mutations
-    ind.mutateBinomial(0.0);
+    ind.mutateBinomial(0.0, arch);
 
     // Check
     BOOST_CHECK_EQUAL(ind.countAlleles(), 0u);
 
     // Same with shuffle
-    ind.mutateShuffle(0.0);
+    ind.mutateShuffle(0.0, arch);
 
     // Check
     BOOST_CHECK_EQUAL(ind.countAlleles(), 0u);
@@ -236,13 +236,13 @@ BOOST_AUTO_TEST_CASE(nonZeroBinomialMutation) {
     pars.nloci = 1000u;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
 
     // Binomial mutation with some probability
-    ind.mutateBinomial(0.5);
+    ind.mutateBinomial(0.5, arch);
 
     // Check that some alleles have been mutated
     BOOST_CHECK(ind.countAlleles() > 0u); 
@@ -256,7 +256,7 @@ BOOST_AUTO_TEST_CASE(noChangeIfRecombinationIsZero) {
     Parameters pars;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
@@ -265,7 +265,7 @@ BOOST_AUTO_TEST_CASE(noChangeIfRecombinationIsZero) {
     Individual pollen(1.0, arch);
 
     // Recombine with rate zero
-    ind.recombine(0.0, pollen);
+    ind.recombine(0.0, pollen, arch);
 
     // Should not have inherited any of the 1-alleles
     BOOST_CHECK_EQUAL(ind.countAlleles(), 0u);
@@ -282,7 +282,7 @@ BOOST_AUTO_TEST_CASE(nonZeroRecombination) {
     pars.nloci = 100u;
 
     // Create architecture
-    std::shared_ptr<Architecture> arch = std::make_shared<Architecture>(Architecture(pars));
+    Architecture arch(pars);
 
     // Create individual
     Individual ind(0.0, arch);
@@ -297,10 +297,54 @@ BOOST_AUTO_TEST_CASE(nonZeroRecombination) {
     const size_t dad = pollen.countAlleles();
 
     // Recombine with some rate
-    ind.recombine(30.0, pollen);
+    ind.recombine(30.0, pollen, arch);
 
     // New sum of alleles should be between original and pollen donor
     BOOST_CHECK(ind.countAlleles() > mom);
     BOOST_CHECK(ind.countAlleles() < dad);
 
-}
\ No newline at end of file
+}
+
+// Test that large numbers of seeds are kept as they are
+BOOST_AUTO_TEST_CASE(largeNumberOfSeedsIsKept) {
+
+    // Create architecture
+    Architecture arch = Architecture(Parameters());
+
+    // Create an individual
+    Individual ind(0.0, arch);
+
+    // Set a very large number of seeds
+    ind.setNSeeds(100000u);
+
+    // Check that it was not capped
+    BOOST_CHECK_EQUAL(ind.getNSeeds(), 100000u);
+
+}
+
+// Test that an individual only takes the space of its attributes and genome
+BOOST_AUTO_TEST_CASE(individualIsCompact) {
+
+    // Note: trait value (8 bytes), deme (4), patch (1) and number of seeds (4)
+    // fit in 24 bytes, followed by the genome words.
+
+    // Check
+    BOOST_CHECK_EQUAL(sizeof(Individual), 24u + sizeof(std::vector<gen::word>));
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 130u;
+
+    // Create architecture
+    Architecture arch = Architecture(pars);
+
+    // Create an individual with allele 1 everywhere
+    Individual ind(1.0, arch);
+
+    // Check that its genome only takes the words the architecture needs
+    BOOST_CHECK_EQUAL(arch.nwords, 3u);
+    BOOST_CHECK_EQUAL(ind.countAlleles(), 130u);
+
+}
@@ -0,0 +1,127 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests that have to do with the kernels of the krn namespace.
+
+#include "../src/kernels.hpp"
+#include "../src/population.hpp"
+#include <boost/test/unit_test.hpp>
+
+// Test that the approximate exponential is accurate
+BOOST_AUTO_TEST_CASE(approximateExponentialIsAccurate) {
+
+    // For many values across a wide range...
+    for (double x = -700.0; x <= 700.0; x += 0.0137) {
+
+        // Check that the relative error is small
+        BOOST_CHECK_CLOSE(krn::exp(x), std::exp(x), 1e-7);
+
+    }
+
+    // Check exact values
+    BOOST_CHECK_EQUAL(krn::exp(0.0), 1.0);
+
+    // Note: the tolerance is in percent, so this checks for a relative
+    // error below 1e-9.
+
+}
+
+// Test that the approximate exponential stays finite and positive
+BOOST_AUTO_TEST_CASE(approximateExponentialIsClamped) {
+
+    // Check extreme values
+    BOOST_CHECK(krn::exp(-1e9) > 0.0);
+    BOOST_CHECK(krn::exp(-1e9) < 1e-300);
+    BOOST_CHECK(std::isfinite(krn::exp(1e9)));
+
+}
+
+// Test that exponentiating a block gives the same as one value at a time
+BOOST_AUTO_TEST_CASE(blockExponentialMatchesScalar) {
+
+    // Note: when built with AVX2 instructions (e.g. with -DNATIVE=ON), blocks
+    // of four values go through the AVX2 path, which must round exactly like
+    // the scalar one.
+
+    // Number of values (not a multiple of four on purpose)
+    const size_t n = 10003u;
+
+    // Prepare values across the whole range (and beyond, to be clamped)
+    std::vector<double> x(n);
+    for (size_t j = 0u; j < n; ++j) x[j] = -750.0 + 0.15 * j + 0.1 * rnd::unit(rnd::rng);
+
+    // Copy
+    std::vector<double> y = x;
+
+    // Exponentiate as a block
+    krn::exps(y.data(), n);
+
+    // Check that each value is exactly the same as when taken alone
+    for (size_t j = 0u; j < n; ++j) BOOST_CHECK_EQUAL(y[j], krn::exp(x[j]));
+
+}
+
+// Test that the fecundity kernel agrees with the Ricker function
+BOOST_AUTO_TEST_CASE(fecundityKernelMatchesRicker) {
+
+    // Parameters of the trade-off
+    const double xmax = 2.0;
+    const double rmax = 2.0;
+    const double epsilon = 0.5;
+
+    // Carrying capacity
+    const double K = 10.0;
+
+    // Trait values and local densities
+    const std::vector<double> x = {0.0, 0.1, 0.5, 1.0, 1.5, 2.0, 0.3};
+    const std::vector<size_t> m = {0u, 5u, 12u, 10u, 40u, 1u, 7u};
+
+    // Number of plants
+    const size_t n = x.size();
+
+    // Crowding terms
+    std::vector<double> c(n);
+    for (size_t j = 0u; j < n; ++j) c[j] = 1.0 - m[j] / K;
+
+    // For linear and non-linear trade-offs...
+    for (double nu : {1.0, 0.5, 2.0}) {
+
+        // Compute expected numbers of seeds
+        std::vector<double> w(n);
+        krn::fecundity(w.data(), x.data(), c.data(), n, xmax, rmax, epsilon, nu);
+
+        // For each plant...
+        for (size_t j = 0u; j < n; ++j) {
+
+            // Growth rate
+            const double r = pop::growth(x[j], xmax, rmax, epsilon, nu);
+
+            // Check against the Ricker function
+            BOOST_CHECK_CLOSE(w[j], pop::ricker(m[j], r, K), 1e-7);
+
+        }
+    }
+}
+
+// Test that the masked sum picks the right values, in a fixed order
+BOOST_AUTO_TEST_CASE(dotKernelMatchesPartialSums) {
+
+    // Random words and values
+    std::array<std::uint64_t, 4u> bits;
+    for (auto &w : bits) w = rnd::rng();
+    std::vector<double> values(256u);
+    for (auto &v : values) v = rnd::unit(rnd::rng);
+
+    // For different numbers of values (including odd ones)...
+    for (size_t n : {0u, 1u, 3u, 4u, 63u, 64u, 65u, 130u, 256u}) {
+
+        // Partial sums computed the slow way
+        std::array<double, 4u> sums = {0.0, 0.0, 0.0, 0.0};
+        for (size_t i = 0u; i < n; ++i)
+            if ((bits[i / 64u] >> (i % 64u)) & 1u) sums[i % 4u] += values[i];
+
+        // Check that the kernel gives exactly the same
+        BOOST_CHECK_EQUAL(krn::dot(bits.data(), values.data(), n), (sums[0u] + sums[1u]) + (sums[2u] + sums[3u]));
+
+    }
+}
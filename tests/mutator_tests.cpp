@@ -0,0 +1,266 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests that have to do with the Mutator class.
+
+#include "testutils.hpp"
+#include "../src/mutator.hpp"
+#include <boost/test/unit_test.hpp>
+
+// Test that nothing mutates when the mutation rate is zero
+BOOST_AUTO_TEST_CASE(mutatorDoesNothingWithZeroRate) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Mutator
+    Mutator mutator(0.0, arch, rng);
+
+    // For many genomes...
+    for (size_t i = 0u; i < 100u; ++i) {
+
+        // Empty genome
+        std::array<gen::word, gen::NWORDS> alleles{};
+        double tol = 0.0;
+
+        // Mutate
+        mutator.mutate(alleles.data(), tol, rng);
+
+        // Check that nothing has changed
+        BOOST_CHECK_EQUAL(gen::count(alleles.data(), arch.nwords), 0u);
+        BOOST_CHECK_EQUAL(tol, 0.0);
+
+    }
+}
+
+// Test that everything mutates when the mutation rate is one
+BOOST_AUTO_TEST_CASE(mutatorFlipsAllWithRateOne) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Mutator
+    Mutator mutator(1.0, arch, rng);
+
+    // For a few genomes...
+    for (size_t i = 0u; i < 10u; ++i) {
+
+        // Empty genome
+        std::array<gen::word, gen::NWORDS> alleles{};
+        double tol = 0.0;
+
+        // Mutate
+        mutator.mutate(alleles.data(), tol, rng);
+
+        // Check that all loci have mutated
+        BOOST_CHECK_EQUAL(gen::count(alleles.data(), arch.nwords), arch.nloci);
+
+    }
+}
+
+// Test that mutations accumulate at the expected rate across genomes
+BOOST_AUTO_TEST_CASE(mutatorSamplesExpectedNumberOfMutations) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak (few loci so most mutations fall across genome boundaries)
+    pars.nloci = 10u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Mutation rate
+    const double mu = 0.01;
+
+    // Mutator
+    Mutator mutator(mu, arch, rng);
+
+    // Number of genomes
+    const size_t n = 100000u;
+
+    // Prepare to count mutations
+    size_t total = 0u;
+
+    // For each genome...
+    for (size_t i = 0u; i < n; ++i) {
+
+        // Empty genome
+        std::array<gen::word, gen::NWORDS> alleles{};
+        double tol = 0.0;
+
+        // Mutate
+        mutator.mutate(alleles.data(), tol, rng);
+
+        // Count mutations
+        const size_t count = gen::count(alleles.data(), arch.nwords);
+
+        // Check that the trait value is consistent with the genome
+        double expected = 0.0;
+        for (size_t j = 0u; j < arch.nloci; ++j)
+            expected += arch.effects[j] * gen::test(alleles.data(), j);
+        BOOST_CHECK_CLOSE(tol, expected, 1e-6);
+
+        // Record
+        total += count;
+
+    }
+
+    // Expected number of mutations
+    const double mean = mu * n * pars.nloci;
+
+    // Check that it is within a few standard deviations
+    BOOST_CHECK(std::abs(total - mean) < 5.0 * std::sqrt(mean));
+
+}
+
+// Test that every sampler mutates at the expected rate
+BOOST_AUTO_TEST_CASE(mutatorSamplersAgree) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak (loci spanning more than one word)
+    pars.nloci = 100u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Number of genomes
+    const size_t n = 2000u;
+
+    // For each sampler...
+    for (size_t s = Mutator::GAPS; s < Mutator::NSAMPLERS; ++s) {
+
+        // For low and high mutation rates...
+        for (double mu : {0.01, 0.5}) {
+
+            // Random number generator
+            rnd::generator rng(42u);
+
+            // Mutator
+            Mutator mutator(mu, arch, rng, s);
+
+            // Prepare to count mutations
+            size_t total = 0u;
+
+            // For each genome...
+            for (size_t i = 0u; i < n; ++i) {
+
+                // Empty genome
+                std::array<gen::word, gen::NWORDS> alleles{};
+                double tol = 0.0;
+
+                // Mutate
+                mutator.mutate(alleles.data(), tol, rng);
+
+                // Check that the trait value is consistent with the genome
+                double expected = 0.0;
+                for (size_t j = 0u; j < arch.nloci; ++j)
+                    expected += arch.effects[j] * gen::test(alleles.data(), j);
+                BOOST_CHECK_CLOSE(tol, expected, 1e-6);
+
+                // Check that nothing is set beyond the last locus
+                BOOST_CHECK_EQUAL(gen::count(alleles.data(), arch.nwords), gen::count(alleles.data(), gen::NWORDS));
+
+                // Record
+                total += gen::count(alleles.data(), arch.nwords);
+
+            }
+
+            // Expected number of mutations and its standard deviation
+            const double mean = mu * n * pars.nloci;
+            const double sd = std::sqrt(mean * (1.0 - mu));
+
+            // Check that it is within a few standard deviations
+            BOOST_CHECK(std::abs(total - mean) < 5.0 * sd);
+
+        }
+    }
+}
+
+// Test that only the gap sampler skips genomes
+BOOST_AUTO_TEST_CASE(mutatorSkipsOnlyWithGaps) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Mutators with a low rate
+    Mutator gaps(1e-6, arch, rng, Mutator::GAPS);
+    Mutator bernoulli(1e-6, arch, rng, Mutator::BERNOULLI);
+
+    // Check
+    BOOST_CHECK(gaps.skip(100u) > 0u);
+    BOOST_CHECK_EQUAL(bernoulli.skip(100u), 0u);
+
+}
+
+// Test that tuning picks one of the samplers and times them all
+BOOST_AUTO_TEST_CASE(mutatorTunesItself) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Prepare to record timings
+    std::vector<double> timings;
+
+    // Tune
+    const size_t best = Mutator::tune(0.01, arch, timings);
+
+    // Check
+    BOOST_CHECK(best != Mutator::AUTO);
+    BOOST_CHECK(best < Mutator::NSAMPLERS);
+    BOOST_CHECK_EQUAL(timings.size(), Mutator::NSAMPLERS);
+    for (size_t s = Mutator::GAPS; s < Mutator::NSAMPLERS; ++s) {
+        BOOST_CHECK(timings[s] > 0.0);
+        BOOST_CHECK(timings[best] <= timings[s]);
+    }
+
+    // Append the timings to a parameter file
+    tst::write("p1.txt", "sampler " + std::to_string(best) + "\n");
+    Mutator::report("p1.txt", timings);
+
+    // Check that the file can still be read as parameters
+    Parameters saved("p1.txt");
+    BOOST_CHECK_EQUAL(saved.sampler, best);
+
+    // Remove files
+    std::remove("p1.txt");
+
+    // Tune with the other engines of the simulation
+    for (size_t engine : {1u, 2u}) {
+
+        // Tune
+        const size_t pick = Mutator::tune(0.01, arch, timings, engine);
+
+        // Check
+        BOOST_CHECK(pick != Mutator::AUTO);
+        BOOST_CHECK(pick < Mutator::NSAMPLERS);
+        for (size_t s = Mutator::GAPS; s < Mutator::NSAMPLERS; ++s) BOOST_CHECK(timings[pick] <= timings[s]);
+
+    }
+}
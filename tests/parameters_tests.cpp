@@ -40,6 +40,7 @@ BOOST_AUTO_TEST_CASE(readParameters)
     content << "steep 0.1\n";
     content << "dispersal 0.1\n";
     content << "mutation 0.1\n";
+    content << "sampler 2\n";
     content << "recombination 0.1\n";
     content << "nloci 4\n";
     content << "effect 0.1\n";
@@ -54,6 +55,15 @@ BOOST_AUTO_TEST_CASE(readParameters)
     content << "twarming 10\n";
     content << "tchange 10\n";
     content << "seed 42\n";
+    content << "engine 1\n";
+    content << "nthreads 4\n";
+    content << "splitting 1\n";
+    content << "vectorize 1\n";
+    content << "pooling 1\n";
+    content << "cohorts 1\n";
+    content << "pruning 1\n";
+    content << "sparse 1\n";
+    content << "batching 1\n";
     content << "sow 1\n";
     content << "loadarch 0\n";
     content << "savepars 1\n";
@@ -87,6 +97,7 @@ BOOST_AUTO_TEST_CASE(readParameters)
     BOOST_CHECK_EQUAL(pars.steep, 0.1);
     BOOST_CHECK_EQUAL(pars.dispersal, 0.1);
     BOOST_CHECK_EQUAL(pars.mutation, 0.1);
+    BOOST_CHECK_EQUAL(pars.sampler, 2u);
     BOOST_CHECK_EQUAL(pars.recombination, 0.1);
     BOOST_CHECK_EQUAL(pars.nloci, 4u);
     BOOST_CHECK_EQUAL(pars.effect, 0.1);
@@ -101,6 +112,15 @@ BOOST_AUTO_TEST_CASE(readParameters)
     BOOST_CHECK_EQUAL(pars.twarming, 10u);
     BOOST_CHECK_EQUAL(pars.tchange, 10u);
     BOOST_CHECK_EQUAL(pars.seed, 42u);
+    BOOST_CHECK_EQUAL(pars.engine, 1u);
+    BOOST_CHECK_EQUAL(pars.nthreads, 4u);
+    BOOST_CHECK(pars.splitting);
+    BOOST_CHECK(pars.vectorize);
+    BOOST_CHECK(pars.pooling);
+    BOOST_CHECK(pars.cohorts);
+    BOOST_CHECK(pars.pruning);
+    BOOST_CHECK(pars.sparse);
+    BOOST_CHECK(pars.batching);
     BOOST_CHECK(pars.sow);
     BOOST_CHECK(!pars.loadarch);
     BOOST_CHECK(pars.savepars);
@@ -368,17 +388,35 @@ BOOST_AUTO_TEST_CASE(readInvalidMutation)
 
 }
 
+// Test error upon invalid mutation sampler
+BOOST_AUTO_TEST_CASE(readInvalidSampler)
+{
+
+    // Write a file with invalid mutation sampler
+    tst::write("p1.txt", "sampler 1 1");
+    tst::write("p2.txt", "sampler 5");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter sampler in line 1 of file p1.txt");
+    tst::checkError([&]() { Parameters pars("p2.txt"); }, "Parameter sampler must be 0, 1, 2, 3 or 4 in line 1 of file p2.txt");
+
+    // Remove files
+    std::remove("p1.txt");
+    std::remove("p2.txt");
+
+}
+
 // Test error upon invalid number of loci
 BOOST_AUTO_TEST_CASE(readInvalidNLoci)
 {
 
     // Write a file with invalid number of loci
     tst::write("p1.txt", "nloci 10 10");
-    tst::write("p2.txt", "nloci 1001");
+    tst::write("p2.txt", "nloci 100001");
     
     // Check
     tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter nloci in line 1 of file p1.txt");
-    tst::checkError([&]() { Parameters pars("p2.txt"); }, "Parameter nloci must be between 1 and 1000 in line 1 of file p2.txt");
+    tst::checkError([&]() { Parameters pars("p2.txt"); }, "Parameter nloci must be between 1 and 100000 in line 1 of file p2.txt");
 
     // Remove files
     std::remove("p1.txt");
@@ -596,6 +634,147 @@ BOOST_AUTO_TEST_CASE(readInvalidSeed)
     
 }
 
+// Test error upon invalid random number engine
+BOOST_AUTO_TEST_CASE(readInvalidEngine)
+{
+
+    // Write a file with invalid random number engine
+    tst::write("p1.txt", "engine 3");
+    tst::write("p2.txt", "engine 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Parameter engine must be 0, 1 or 2 in line 1 of file p1.txt");
+    tst::checkError([&]() { Parameters pars("p2.txt"); }, "Too many values for parameter engine in line 1 of file p2.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+    std::remove("p2.txt");
+    
+}
+
+// Test error upon invalid number of threads
+BOOST_AUTO_TEST_CASE(readInvalidNThreads)
+{
+
+    // Write a file with invalid number of threads
+    tst::write("p1.txt", "nthreads 0");
+    tst::write("p2.txt", "nthreads 2 2");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Parameter nthreads must be strictly positive in line 1 of file p1.txt");
+    tst::checkError([&]() { Parameters pars("p2.txt"); }, "Too many values for parameter nthreads in line 1 of file p2.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+    std::remove("p2.txt");
+    
+}
+
+// Test that error upon invalid seed splitting flag
+BOOST_AUTO_TEST_CASE(readInvalidSplitting)
+{
+
+    // Write a file with invalid seed splitting flag
+    tst::write("p1.txt", "splitting 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter splitting in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid vectorization flag
+BOOST_AUTO_TEST_CASE(readInvalidVectorize)
+{
+
+    // Write a file with invalid vectorization flag
+    tst::write("p1.txt", "vectorize 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter vectorize in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid pooling flag
+BOOST_AUTO_TEST_CASE(readInvalidPooling)
+{
+
+    // Write a file with invalid pooling flag
+    tst::write("p1.txt", "pooling 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter pooling in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid cohort flag
+BOOST_AUTO_TEST_CASE(readInvalidCohorts)
+{
+
+    // Write a file with invalid cohort flag
+    tst::write("p1.txt", "cohorts 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter cohorts in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid pruning flag
+BOOST_AUTO_TEST_CASE(readInvalidPruning)
+{
+
+    // Write a file with invalid pruning flag
+    tst::write("p1.txt", "pruning 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter pruning in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid sparse flag
+BOOST_AUTO_TEST_CASE(readInvalidSparse)
+{
+
+    // Write a file with invalid sparse flag
+    tst::write("p1.txt", "sparse 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter sparse in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
+// Test that error upon invalid batching flag
+BOOST_AUTO_TEST_CASE(readInvalidBatching)
+{
+
+    // Write a file with invalid batching flag
+    tst::write("p1.txt", "batching 1 1");
+    
+    // Check
+    tst::checkError([&]() { Parameters pars("p1.txt"); }, "Too many values for parameter batching in line 1 of file p1.txt");
+    
+    // Remove files
+    std::remove("p1.txt");
+
+}
+
 // Test that error upon invalid sowing flag
 BOOST_AUTO_TEST_CASE(readInvalidSow)
 {
@@ -0,0 +1,120 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests that have to do with the Pool class.
+
+#include "../src/pool.hpp"
+#include <boost/test/unit_test.hpp>
+#include <array>
+
+// Test that identical genomes are only kept once
+BOOST_AUTO_TEST_CASE(poolKeepsDistinctGenomes) {
+
+    // Create a pool
+    Pool pool(2u);
+
+    // A few genomes
+    const std::array<gen::word, 2u> a = {1u, 2u}, b = {1u, 3u};
+
+    // Add them, one of them twice
+    const size_t ha1 = pool.intern(a.data());
+    const size_t hb = pool.intern(b.data());
+    const size_t ha2 = pool.intern(a.data());
+
+    // Check
+    BOOST_CHECK_EQUAL(ha1, ha2);
+    BOOST_CHECK(ha1 != hb);
+    BOOST_CHECK_EQUAL(pool.unique(), 2u);
+    BOOST_CHECK_EQUAL(pool.count(ha1), 2u);
+    BOOST_CHECK_EQUAL(pool.count(hb), 1u);
+
+    // Check that the genomes can be read back
+    BOOST_CHECK(std::equal(a.begin(), a.end(), pool.genome(ha1)));
+    BOOST_CHECK(std::equal(b.begin(), b.end(), pool.genome(hb)));
+
+}
+
+// Test that genomes are freed when nobody refers to them
+BOOST_AUTO_TEST_CASE(poolFreesUnusedGenomes) {
+
+    // Create a pool
+    Pool pool(1u);
+
+    // A genome
+    const gen::word a = 42u;
+
+    // Add it and refer to it once more
+    const size_t h = pool.intern(&a);
+    pool.acquire(h);
+
+    // Let go of it once
+    pool.release(h);
+
+    // Check that it is still there
+    BOOST_CHECK_EQUAL(pool.unique(), 1u);
+    BOOST_CHECK_EQUAL(pool.count(h), 1u);
+
+    // Let go of it again
+    pool.release(h);
+
+    // Check that it is gone
+    BOOST_CHECK_EQUAL(pool.unique(), 0u);
+    BOOST_CHECK_EQUAL(pool.count(h), 0u);
+
+    // Add another genome
+    const gen::word b = 7u;
+    const size_t k = pool.intern(&b);
+
+    // Check that the slot has been reused
+    BOOST_CHECK_EQUAL(k, h);
+    BOOST_CHECK_EQUAL(*pool.genome(k), 7u);
+
+    // Check that the first genome is not found anymore
+    BOOST_CHECK_EQUAL(pool.count(pool.intern(&a)), 1u);
+    BOOST_CHECK_EQUAL(pool.unique(), 2u);
+
+}
+
+// Test that the pool copes with many genomes coming and going
+BOOST_AUTO_TEST_CASE(poolHandlesManyGenomes) {
+
+    // Create a pool
+    Pool pool(1u);
+
+    // Prepare to record handles
+    std::vector<size_t> handles;
+
+    // Add many genomes (each twice)
+    for (gen::word x = 0u; x < 1000u; ++x) {
+        handles.push_back(pool.intern(&x));
+        BOOST_CHECK_EQUAL(pool.intern(&x), handles.back());
+    }
+
+    // Check
+    BOOST_CHECK_EQUAL(pool.unique(), 1000u);
+
+    // Remove every other genome
+    for (size_t x = 0u; x < 1000u; x += 2u) {
+        pool.release(handles[x]);
+        pool.release(handles[x]);
+    }
+
+    // Check
+    BOOST_CHECK_EQUAL(pool.unique(), 500u);
+
+    // Check that the remaining ones are still found
+    for (gen::word x = 1u; x < 1000u; x += 2u) {
+        BOOST_CHECK_EQUAL(pool.intern(&x), handles[x]);
+        BOOST_CHECK_EQUAL(*pool.genome(handles[x]), x);
+    }
+
+    // Add them back along with new ones
+    for (gen::word x = 0u; x < 2000u; x += 2u) pool.intern(&x);
+
+    // Check
+    BOOST_CHECK_EQUAL(pool.unique(), 1500u);
+
+    // Check that the pool reports the memory it takes
+    BOOST_CHECK(pool.memory() >= 1500u * sizeof(gen::word));
+
+}
@@ -6,6 +6,38 @@
 #include "testutils.hpp"
 #include "../src/population.hpp"
 #include <boost/test/unit_test.hpp>
+#include <tuple>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include <atomic>
+
+// Number of heap allocations counted so far, and whether to count them
+static std::atomic<size_t> nallocations(0u);
+static std::atomic<bool> counting(false);
+
+// Note: the global allocation functions are replaced so that allocations can
+// be counted (see populationSteadyStateDoesNotAllocate). Every form of new is
+// backed by malloc and every form of delete by free, so they all match.
+
+// Allocate (and count if needed)
+static void* allocate(std::size_t n) {
+
+    if (counting) ++nallocations;
+    if (void *p = std::malloc(n ? n : 1u)) return p;
+    throw std::bad_alloc();
+
+}
+
+// Allocate
+void* operator new(std::size_t n) { return allocate(n); }
+void* operator new[](std::size_t n) { return allocate(n); }
+
+// Free
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
 
 // Test that a population initializes properly
 BOOST_AUTO_TEST_CASE(populationInitializesProperly) {
@@ -330,6 +362,109 @@ BOOST_AUTO_TEST_CASE(populationCanPrint) {
 
 }
 
+// Test that statistics gathered as newborns join match the individuals saved
+BOOST_AUTO_TEST_CASE(populationStatisticsMatchIndividuals) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 3u;
+    pars.pgood = { 0.2, 0.5, 0.8 };
+    pars.pgoodEnd = { 0.2, 0.5, 0.8 };
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.tsave = 1u;
+    pars.sow = true;
+
+    // Note: statistics are gathered while newborns are sorted into the
+    // population (see Population::bucket), and saved at the start of the next
+    // generation. Here they are computed again in a separate pass over the
+    // individuals saved in the same generation, adding them up in the same
+    // order, so both should match exactly.
+
+    // Number of generations
+    const size_t ngens = 5u;
+
+    // Seed the global random number generator
+    rnd::rng.seed(pars.seed);
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Population
+    Population pop(pars, arch);
+
+    // Printer
+    Printer print({"popsize", "patchsizes", "traitmeans", "individuals"});
+
+    // Open the printer
+    print.open();
+
+    // Run a few generations
+    for (size_t t = 0u; t < ngens && !pop.extinct(); ++t) {
+
+        pop.cycle(print);
+        pop.moveon();
+
+    }
+
+    // Close the printer
+    print.close();
+
+    // Read values back in
+    std::vector<double> popsize = tst::read("popsize.dat");
+    std::vector<double> patchsizes = tst::read("patchsizes.dat");
+    std::vector<double> traitmeans = tst::read("traitmeans.dat");
+    std::vector<double> individuals = tst::read("individuals.dat");
+
+    // Check that every generation was saved
+    BOOST_REQUIRE_EQUAL(popsize.size(), ngens);
+    BOOST_REQUIRE_EQUAL(patchsizes.size(), ngens * 2u * pars.ndemes);
+    BOOST_REQUIRE_EQUAL(traitmeans.size(), ngens * 2u * pars.ndemes);
+
+    // Position of the first individual of the current generation
+    size_t first = 0u;
+
+    // For each generation...
+    for (size_t t = 0u; t < ngens; ++t) {
+
+        // Recompute the statistics from the individuals saved
+        size_t n = 0u;
+        std::vector<double> sizes(2u * pars.ndemes, 0.0), means(2u * pars.ndemes, 0.0);
+        for (size_t i = first; i < first + 3u * popsize[t] && i + 2u < individuals.size(); i += 3u, ++n) {
+            const size_t j = 2u * individuals[i] + individuals[i + 1u];
+            sizes[j] += 1.0;
+            means[j] += individuals[i + 2u];
+        }
+        for (size_t j = 0u; j < sizes.size(); ++j) if (sizes[j] > 0.0) means[j] /= sizes[j];
+
+        // Check that they match those gathered on the way
+        BOOST_CHECK_EQUAL(n, popsize[t]);
+        for (size_t j = 0u; j < sizes.size(); ++j) {
+            BOOST_CHECK_EQUAL(patchsizes[t * sizes.size() + j], sizes[j]);
+            BOOST_CHECK_EQUAL(traitmeans[t * sizes.size() + j], means[j]);
+        }
+
+        // Move on to the next generation
+        first += 3u * n;
+
+    }
+
+    // Check that all individuals were looked at
+    BOOST_CHECK_EQUAL(first, individuals.size());
+
+    // Remove files
+    std::remove("popsize.dat");
+    std::remove("patchsizes.dat");
+    std::remove("traitmeans.dat");
+    std::remove("individuals.dat");
+
+}
+
 // Test that population with non-linear trade-off works
 BOOST_AUTO_TEST_CASE(populationWithNonLinearTradeOff) {
 
@@ -465,6 +600,43 @@ BOOST_AUTO_TEST_CASE(populationCycleWithDispersal) {
 
 }
 
+// Test that individuals are kept sorted by deme and patch
+BOOST_AUTO_TEST_CASE(populationKeepsIndividualsBucketed) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 500u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.5, 0.5, 0.5, 0.5, 0.5 };
+    pars.pgoodEnd = { 0.5, 0.5, 0.5, 0.5, 0.5 };
+    pars.dispersal = 0.5;
+    pars.sow = true;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Create a population
+    Population pop(pars, arch);
+
+    // Printer
+    Printer print({"foo", "bar"});
+
+    // For a few generations...
+    for (size_t t = 0u; t < 5u && !pop.extinct(); ++t) {
+
+        // Check that each individual comes after those of earlier buckets
+        for (size_t i = 1u; i < pop.size(); ++i)
+            BOOST_CHECK(2u * pop.getDeme(i - 1u) + pop.getPatch(i - 1u) <= 2u * pop.getDeme(i) + pop.getPatch(i));
+
+        // Cycle
+        pop.cycle(print);
+        pop.moveon();
+
+    }
+}
+
 // Population cycle with no dispersal (PROBABILISTIC)
 BOOST_AUTO_TEST_CASE(populationCycleWithNoDispersal) {
 
@@ -642,4 +814,830 @@ BOOST_AUTO_TEST_CASE(populationCycleTooHarshForSurvival) {
     // Check patch
     BOOST_CHECK_EQUAL(pop.size(), 0u);
 
-}
\ No newline at end of file
+}
+
+// Test that the outcome does not depend on the number of threads
+BOOST_AUTO_TEST_CASE(populationReproducibleAcrossThreads) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // Prepare to record the outcome of each run
+    std::vector<std::vector<double> > outcomes;
+
+    // For different numbers of threads...
+    for (size_t nthreads : {1u, 2u, 4u}) {
+
+        // Set the number of threads and record the outcome
+        pars.nthreads = nthreads;
+        outcomes.push_back(tst::runAndRecord(pars));
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(!outcomes[0u].empty());
+
+    // Check that all runs gave exactly the same population
+    BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+    BOOST_CHECK(outcomes[2u] == outcomes[0u]);
+
+    // Check that the streams of the demes still depend on the seed
+    pars.seed = 43u;
+    BOOST_CHECK(tst::runAndRecord(pars) != outcomes[0u]);
+
+}
+
+// Test that large numbers of seeds do not depend on the number of threads
+BOOST_AUTO_TEST_CASE(populationLargeBroodsReproducibleAcrossThreads) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak (few plants, far below carrying capacity)
+    pars.seed = 42u;
+    pars.popsize = 10u;
+    pars.ndemes = 8u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.maxgrowth = 4.0;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // Note: plants then expect more than ten seeds each, so numbers of seeds
+    // are drawn by transformed rejection rather than from a table.
+
+    // Prepare to record the outcome of each run
+    std::vector<std::vector<double> > outcomes;
+
+    // For different numbers of threads...
+    for (size_t nthreads : {1u, 4u}) {
+
+        // Set the number of threads and record the outcome
+        pars.nthreads = nthreads;
+        outcomes.push_back(tst::runAndRecord(pars, 1u));
+
+    }
+
+    // Check that plants did have more than ten surviving seeds on average
+    const std::vector<double> adults = tst::runAndRecord(pars, 0u);
+    BOOST_CHECK_GT(outcomes[0u].size(), 10u * adults.size());
+
+    // Check that both runs gave exactly the same population
+    BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+
+}
+
+// Test that non-default engines do not depend on the number of threads either
+BOOST_AUTO_TEST_CASE(populationOtherEnginesReproducibleAcrossThreads) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // Outcome with the default engine
+    const std::vector<double> baseline = tst::runAndRecord(pars);
+
+    // For each engine other than the default...
+    for (size_t engine : {1u, 2u}) {
+
+        // Set the engine
+        pars.engine = engine;
+
+        // Prepare to record the outcome of each run
+        std::vector<std::vector<double> > outcomes;
+
+        // For different numbers of threads...
+        for (size_t nthreads : {1u, 2u, 4u}) {
+
+            // Set the number of threads and record the outcome
+            pars.nthreads = nthreads;
+            outcomes.push_back(tst::runAndRecord(pars));
+
+        }
+
+        // Check that the population did not die out
+        BOOST_CHECK(!outcomes[0u].empty());
+
+        // Check that all runs gave exactly the same population
+        BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+        BOOST_CHECK(outcomes[2u] == outcomes[0u]);
+
+        // Check that the engine was really switched (other streams, other outcome)
+        BOOST_CHECK(outcomes[0u] != baseline);
+
+    }
+}
+
+// Test that splitting seed fates gives the same outcome on average
+BOOST_AUTO_TEST_CASE(populationSplittingMatchesSeedBySeed) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 1000u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.2, 0.4, 0.5, 0.6, 0.8 };
+    pars.pgoodEnd = { 0.2, 0.4, 0.5, 0.6, 0.8 };
+    pars.stress = { 1.0, 0.0 };
+    pars.stressEnd = { 1.0, 0.0 };
+    pars.allfreq = 0.5;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.9;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // Average outcomes seed by seed, then with split fates
+    pars.splitting = false;
+    const std::array<double, 3u> direct = tst::runAndAverage(pars);
+    pars.splitting = true;
+    const std::array<double, 3u> split = tst::runAndAverage(pars);
+
+    // Check that both modes agree (size, trait value and patch)
+    for (size_t k = 0u; k < 3u; ++k) BOOST_CHECK_CLOSE(split[k], direct[k], 2.0);
+
+    // Now make every seed a selfed, non-dispersing, unmutated clone, so that
+    // all of them go through the binomial draws at once
+    pars.seed = 42u;
+    pars.selfing = 1.0;
+    pars.dispersal = 0.0;
+    pars.mutation = 0.0;
+
+    // With many loci, so that most adults have their own trait value
+    pars.nloci = 100u;
+
+    // Record the adults, then their offspring
+    const std::vector<double> adults = tst::runAndRecord(pars, 0u);
+    const std::vector<double> offspring = tst::runAndRecord(pars, 1u);
+
+    // Check that the population did not die out
+    BOOST_REQUIRE(!offspring.empty());
+
+    // Check that each newborn is a clone of an adult of its deme
+    for (size_t i = 0u; i < offspring.size(); i += 3u) {
+
+        // Look for an adult with the same deme and trait value
+        bool found = false;
+        for (size_t j = 0u; j < adults.size() && !found; j += 3u)
+            found = adults[j] == offspring[i] && adults[j + 2u] == offspring[i + 2u];
+
+        // Check
+        BOOST_CHECK(found);
+
+    }
+}
+
+// Test that building seeds in batches gives the same outcome on average
+BOOST_AUTO_TEST_CASE(populationBatchingMatchesSeedBySeed) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 1000u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.2, 0.4, 0.5, 0.6, 0.8 };
+    pars.pgoodEnd = { 0.2, 0.4, 0.5, 0.6, 0.8 };
+    pars.stress = { 1.0, 0.0 };
+    pars.stressEnd = { 1.0, 0.0 };
+    pars.allfreq = 0.5;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.2;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // For each engine...
+    for (size_t engine : {0u, 1u}) {
+
+        // Set it
+        pars.engine = engine;
+
+        // Average outcomes seed by seed, then in batches
+        pars.batching = false;
+        const std::array<double, 3u> direct = tst::runAndAverage(pars);
+        pars.batching = true;
+        const std::array<double, 3u> batched = tst::runAndAverage(pars);
+
+        // Check that both modes agree (size, trait value and patch)
+        for (size_t k = 0u; k < 3u; ++k) BOOST_CHECK_CLOSE(batched[k], direct[k], 2.0);
+
+    }
+
+    // Check that batching draws from other random number streams
+    pars.seed = 42u;
+    pars.batching = false;
+    const std::vector<double> direct = tst::runAndRecord(pars, 1u);
+    pars.batching = true;
+    BOOST_CHECK(tst::runAndRecord(pars, 1u) != direct);
+
+    // Check that it has no effect when seed fates are split
+    pars.splitting = true;
+    const std::vector<double> split = tst::runAndRecord(pars, 1u);
+    pars.batching = false;
+    BOOST_CHECK(!split.empty());
+    BOOST_CHECK(tst::runAndRecord(pars, 1u) == split);
+
+}
+
+// Test that building seeds in lots does not depend on the number of threads
+BOOST_AUTO_TEST_CASE(populationBatchingReproducibleAcrossThreads) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak (few demes, so lots outnumber them)
+    pars.seed = 42u;
+    pars.popsize = 1000u;
+    pars.ndemes = 2u;
+    pars.pgood = { 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8 };
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+    pars.batching = true;
+
+    // For each engine...
+    for (size_t engine : {0u, 1u, 2u}) {
+
+        // Set it
+        pars.engine = engine;
+
+        // Prepare to record the outcome of each run
+        std::vector<std::vector<double> > outcomes;
+
+        // For different numbers of threads...
+        for (size_t nthreads : {1u, 4u}) {
+
+            // Set the number of threads
+            pars.nthreads = nthreads;
+
+            // Check that seeds were built in more lots than there are demes
+            auto inspect = [&](const Population &pop) { BOOST_CHECK_GT(pop.getLots(), pars.ndemes); };
+
+            // Record the outcome
+            outcomes.push_back(tst::runAndRecord(pars, 5u, nullptr, inspect));
+
+        }
+
+        // Check that the population did not die out
+        BOOST_CHECK(!outcomes[0u].empty());
+
+        // Check that both runs gave exactly the same population
+        BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+
+    }
+}
+
+// Test that lookup tables give the same outcome as direct computation
+BOOST_AUTO_TEST_CASE(populationTablesMatchDirectComputation) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.allfreq = 0.5;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // Prepare to record the outcome of each run
+    std::vector<std::vector<double> > outcomes;
+
+    // With and without lookup tables...
+    for (bool uniform : {true, false}) {
+
+        // Check that effect sizes are all the same, then pretend they are
+        // not if needed (so values are computed directly)
+        auto tweak = [&](Architecture &arch) {
+            BOOST_CHECK(arch.uniform);
+            arch.uniform = uniform;
+        };
+
+        // Check that the tables were in use only if effects were uniform
+        auto inspect = [&](const Population &pop) { BOOST_CHECK_EQUAL(pop.getTabulated(), uniform); };
+
+        // Record the outcome
+        outcomes.push_back(tst::runAndRecord(pars, 5u, tweak, inspect));
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(!outcomes[0u].empty());
+
+    // Check that both runs gave the same population
+    tst::checkClose(outcomes[0u], outcomes[1u], 1e-6);
+
+}
+
+// Test that lookup tables are only used when classes are few enough
+BOOST_AUTO_TEST_CASE(populationTablesOnlyWhenWorthIt) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+
+    // Printer
+    Printer print({"foo", "bar"});
+
+    // With few loci (5 demes times 11 classes, for 100 plants)...
+    pars.nloci = 10u;
+
+    // Architecture
+    Architecture arch1(pars);
+
+    // Create a population
+    Population pop1(pars, arch1);
+
+    // Run a generation
+    pop1.cycle(print);
+
+    // Check that the tables are in use
+    BOOST_CHECK(pop1.getTabulated());
+
+    // With many loci (5 demes times 1001 classes, for 100 plants)...
+    pars.nloci = 1000u;
+
+    // Architecture
+    Architecture arch2(pars);
+
+    // Create a population
+    Population pop2(pars, arch2);
+
+    // Run a generation
+    pop2.cycle(print);
+
+    // Check that the tables are not in use
+    BOOST_CHECK(arch2.uniform);
+    BOOST_CHECK(!pop2.getTabulated());
+
+}
+
+// Test that the fecundity kernel gives the same outcome as direct computation
+BOOST_AUTO_TEST_CASE(populationVectorizedMatchesDirectComputation) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.allfreq = 0.5;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.01;
+    pars.sow = true;
+
+    // For a linear then a non-linear trade-off (the kernel has a branch for each)...
+    for (double nonlinear : {1.0, 2.0}) {
+
+        // Set it
+        pars.nonlinear = nonlinear;
+
+        // Record the outcome with and without the kernel
+        pars.vectorize = false;
+        const std::vector<double> direct = tst::runAndRecord(pars);
+        pars.vectorize = true;
+        const std::vector<double> vectorized = tst::runAndRecord(pars);
+
+        // Check that the population did not die out
+        BOOST_CHECK(!direct.empty());
+
+        // Check that both runs gave the same population
+        tst::checkClose(direct, vectorized, 1e-6);
+
+    }
+}
+
+// Test that sharing genomes through a pool does not change the outcome
+BOOST_AUTO_TEST_CASE(populationPoolingMatchesCopying) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.allfreq = 0.5;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.9;
+    pars.recombination = 0.0;
+    pars.mutation = 0.001;
+    pars.sow = true;
+
+    // Note: without recombination, skipping it between identical parents
+    // draws no fewer random numbers, so both runs should match exactly.
+
+    // Prepare to record the outcome of each run
+    std::vector<std::vector<double> > outcomes;
+
+    // With and without the pool...
+    for (bool pooling : {false, true}) {
+
+        // Set the mode
+        pars.pooling = pooling;
+
+        // Check that genomes are shared in the pool (mostly selfed clones),
+        // and that there is one per individual otherwise
+        auto inspect = [&](const Population &pop) {
+            if (pooling) BOOST_CHECK(pop.getGenomes() < pop.size());
+            else BOOST_CHECK_EQUAL(pop.getGenomes(), pop.size());
+        };
+
+        // Record the outcome
+        outcomes.push_back(tst::runAndRecord(pars, 5u, nullptr, inspect));
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(!outcomes[0u].empty());
+
+    // Check that both runs gave exactly the same population
+    BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+
+}
+
+// Test that classes of identical plants start from the same individuals
+BOOST_AUTO_TEST_CASE(populationCohortsStartFromSameIndividuals) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 500u;
+    pars.ndemes = 3u;
+    pars.pgood = { 0.5, 0.5, 0.5 };
+    pars.pgoodEnd = { 0.5, 0.5, 0.5 };
+    pars.nloci = 5u;
+    pars.allfreq = 0.2;
+    pars.sow = true;
+
+    // Prepare to record the individuals of each population
+    std::vector<std::vector<std::tuple<size_t, size_t, double> > > outcomes;
+
+    // With and without cohorts...
+    for (bool cohorts : {false, true}) {
+
+        // Set the mode
+        pars.cohorts = cohorts;
+
+        // Seed the global random number generator the same way
+        rnd::rng.seed(pars.seed);
+
+        // Architecture
+        Architecture arch(pars);
+
+        // Create a population
+        Population pop(pars, arch);
+
+        // Check that identical plants were grouped
+        if (cohorts) BOOST_CHECK(pop.getClasses() < pop.size());
+
+        // Record every individual
+        std::vector<std::tuple<size_t, size_t, double> > outcome;
+        for (size_t i = 0u; i < pop.size(); ++i)
+            outcome.emplace_back(pop.getDeme(i), pop.getPatch(i), pop.getTolerance(i));
+
+        // Sort them (classes do not keep individuals in order)
+        std::sort(outcome.begin(), outcome.end());
+
+        // Save
+        outcomes.push_back(outcome);
+
+    }
+
+    // Check that both populations have the same individuals
+    BOOST_CHECK_EQUAL(outcomes[0u].size(), pars.popsize);
+    BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+
+}
+
+// Test that identical plants stay in a few classes
+BOOST_AUTO_TEST_CASE(populationCohortsKeepIdenticalPlantsTogether) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 1000u;
+    pars.ndemes = 2u;
+    pars.pgood = { 0.5, 0.5 };
+    pars.pgoodEnd = { 0.5, 0.5 };
+    pars.allfreq = 0.0;
+    pars.mutation = 0.0;
+    pars.dispersal = 0.1;
+    pars.sow = true;
+    pars.cohorts = true;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Create a population
+    Population pop(pars, arch);
+
+    // Printer
+    Printer print({"foo", "bar"});
+
+    // Run a few generations
+    for (size_t t = 0u; t < 5u && !pop.extinct(); ++t) {
+
+        pop.cycle(print);
+        pop.moveon();
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(!pop.extinct());
+
+    // Check that there is one class per patch per deme, sharing one genome
+    BOOST_CHECK(pop.getClasses() <= 4u);
+    BOOST_CHECK_EQUAL(pop.getGenomes(), 1u);
+
+    // Check that every plant has the same (empty) genome
+    for (size_t i = 0u; i < pop.size(); ++i) BOOST_CHECK_EQUAL(pop.getTolerance(i), 0.0);
+
+}
+
+// Test that classes of identical plants grow like individuals (PROBABILISTIC)
+BOOST_AUTO_TEST_CASE(populationCohortsGrowLikeIndividuals) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 2000u;
+    pars.ndemes = 1u;
+    pars.pgood = { 0.5 };
+    pars.pgoodEnd = { 0.5 };
+    pars.allfreq = 0.0;
+    pars.mutation = 0.0;
+    pars.sow = false;
+
+    // Note: all plants have the same trait value and are in the same patch,
+    // so the expected number of newborns is the same with or without cohorts.
+
+    // Printer
+    Printer print({"foo", "bar"});
+
+    // Prepare to record the mean number of newborns
+    std::vector<double> means;
+
+    // With and without cohorts...
+    for (bool cohorts : {false, true}) {
+
+        // Set the mode
+        pars.cohorts = cohorts;
+
+        // Prepare to average
+        double mean = 0.0;
+
+        // For a few replicates...
+        for (size_t r = 0u; r < 10u; ++r) {
+
+            // Seed the global random number generator
+            rnd::rng.seed(r + 1u);
+
+            // Architecture
+            Architecture arch(pars);
+
+            // Create a population
+            Population pop(pars, arch);
+
+            // Run one generation
+            pop.cycle(print);
+
+            // Record
+            mean += pop.size() / 10.0;
+
+        }
+
+        // Save
+        means.push_back(mean);
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(means[0u] > 0.0);
+
+    // Check that both modes give about as many newborns
+    BOOST_CHECK_CLOSE(means[1u], means[0u], 5.0);
+
+}
+
+// Test that leaving out fixed loci does not change the outcome
+BOOST_AUTO_TEST_CASE(populationPruningMatchesFullGenomes) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.nloci = 500u;
+    pars.allfreq = 0.0;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.001;
+    pars.sow = true;
+
+    // With equal effects, then different ones...
+    for (bool uniform : {true, false}) {
+
+        // Prepare to record the outcome of each run
+        std::vector<std::vector<double> > outcomes;
+
+        // With and without pruning...
+        for (bool pruning : {false, true}) {
+
+            // Set the mode
+            pars.pruning = pruning;
+
+            // Give each locus its own effect if needed
+            auto tweak = [&](Architecture &arch) {
+                if (uniform) return;
+                for (size_t i = 0u; i < pars.nloci; ++i) arch.effects[i] = 0.001 * (i % 7u + 1u);
+                arch.uniform = false;
+            };
+
+            // Check that the survey finds loci that vary (from mutations)
+            auto inspect = [&](const Population &pop) {
+                if (pruning) BOOST_CHECK(pop.getPolymorphic() > 0u);
+            };
+
+            // Record the outcome
+            outcomes.push_back(tst::runAndRecord(pars, 5u, tweak, inspect));
+
+        }
+
+        // Check that the population did not die out
+        BOOST_CHECK(!outcomes[0u].empty());
+
+        // Check that both runs gave the same population (exactly with equal effects)
+        if (uniform) BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+        else tst::checkClose(outcomes[1u], outcomes[0u], 1e-6);
+
+    }
+
+    // Without mutation, every locus stays fixed (all alleles 0)
+    pars.pruning = true;
+    pars.mutation = 0.0;
+
+    // Check that the survey then finds no locus that varies
+    auto inspect = [&](const Population &pop) { BOOST_CHECK_EQUAL(pop.getPolymorphic(), 0u); };
+    BOOST_CHECK(!tst::runAndRecord(pars, 5u, nullptr, inspect).empty());
+
+}
+
+// Test that storing genomes as lists of positions does not change the outcome
+BOOST_AUTO_TEST_CASE(populationSparseMatchesDense) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.seed = 42u;
+    pars.popsize = 100u;
+    pars.ndemes = 5u;
+    pars.pgood = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.pgoodEnd = { 0.8, 0.8, 0.8, 0.8, 0.8 };
+    pars.nloci = 1000u;
+    pars.allfreq = 0.01;
+    pars.dispersal = 0.1;
+    pars.selfing = 0.5;
+    pars.mutation = 0.0001;
+    pars.sow = true;
+
+    // Prepare to record the outcome of each run and the memory taken
+    std::vector<std::vector<double> > outcomes;
+    std::vector<size_t> memory;
+
+    // With and without lists...
+    for (bool sparse : {false, true}) {
+
+        // Set the mode
+        pars.sparse = sparse;
+
+        // Record the memory taken by the genomes per individual
+        auto inspect = [&](const Population &pop) {
+            memory.push_back(pop.getGenomeMemory() / pop.size());
+        };
+
+        // Record the outcome
+        outcomes.push_back(tst::runAndRecord(pars, 5u, nullptr, inspect));
+
+    }
+
+    // Check that the population did not die out
+    BOOST_CHECK(!outcomes[0u].empty());
+
+    // Check that both runs gave exactly the same population
+    BOOST_CHECK(outcomes[1u] == outcomes[0u]);
+
+    // Check that lists took much less memory (no arena of words left behind)
+    BOOST_CHECK(memory[1u] * 4u < memory[0u]);
+
+}
+
+// Test that a population that has stopped growing makes no heap allocation
+BOOST_AUTO_TEST_CASE(populationSteadyStateDoesNotAllocate) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.popsize = 100u;
+    pars.ndemes = 3u;
+    pars.pgood = { 0.5, 0.5, 0.5 };
+    pars.pgoodEnd = { 0.5, 0.5, 0.5 };
+    pars.capacities = { 100.0, 100.0 };
+    pars.capacitiesEnd = { 100.0, 100.0 };
+    pars.dispersal = 0.1;
+    pars.mutation = 0.01;
+    pars.recombination = 1.0;
+    pars.selfing = 0.5;
+    pars.nloci = 100u;
+    pars.maxgrowth = 1.8;
+    pars.nthreads = 1u;
+
+    // Note: the growth rate is low enough for the population to settle
+    // around its carrying capacity instead of going through cycles.
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Population
+    Population pop(pars, arch);
+
+    // Dummy printer
+    Printer print({"foo", "bar"});
+
+    // Let the population settle and its buffers grow
+    for (size_t t = 0u; t < 100u; ++t) { pop.cycle(print); pop.moveon(); }
+
+    // Check
+    BOOST_REQUIRE(!pop.extinct());
+
+    // Prepare to record the allocations made by each generation
+    std::vector<size_t> allocations(20u, 0u);
+
+    // For each generation...
+    for (size_t &n : allocations) {
+
+        // Count the allocations made during the generation (only)
+        nallocations = 0u;
+        counting = true;
+        pop.cycle(print);
+        pop.moveon();
+        counting = false;
+        n = nallocations;
+
+    }
+
+    // Check that there were none
+    for (const size_t &n : allocations) BOOST_CHECK_EQUAL(n, 0u);
+
+}
@@ -0,0 +1,409 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests of the samplers of the rnd namespace. We check edge cases,
+// and that draws have the expected mean and variance.
+
+#include "../src/random.hpp"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+// Accessory function to compute the mean and variance of many draws
+template <typename F>
+std::pair<double, double> moments(F draw, const size_t &n) {
+
+    // draw: function returning a draw
+    // n: number of draws
+
+    // Prepare to sum
+    double sum = 0.0, sumsq = 0.0;
+
+    // Draw many times
+    for (size_t i = 0u; i < n; ++i) {
+
+        const double x = draw();
+        sum += x;
+        sumsq += x * x;
+
+    }
+
+    // Compute mean and variance
+    const double mean = sum / n;
+    const double var = sumsq / n - mean * mean;
+
+    // Exit
+    return std::make_pair(mean, var);
+
+}
+
+// Test that uniform numbers fall between zero and one
+BOOST_AUTO_TEST_CASE(unitNumbersInRange) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Check many draws
+    for (size_t i = 0u; i < 10000u; ++i) {
+
+        const double x = rnd::unit(rng);
+        BOOST_CHECK(x >= 0.0);
+        BOOST_CHECK(x < 1.0);
+
+    }
+}
+
+// Test the Bernoulli sampler
+BOOST_AUTO_TEST_CASE(bernoulliSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Edge cases
+    for (size_t i = 0u; i < 1000u; ++i) {
+
+        BOOST_CHECK(!rnd::Bernoulli(0.0)(rng));
+        BOOST_CHECK(rnd::Bernoulli(1.0)(rng));
+
+    }
+
+    // Mean of many draws
+    const rnd::Bernoulli sampler(0.3);
+    const auto [mean, var] = moments([&]() { return sampler(rng); }, 100000u);
+    BOOST_CHECK_CLOSE(mean, 0.3, 2.0);
+
+}
+
+// Test the uniform integer sampler
+BOOST_AUTO_TEST_CASE(randomSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Sampler
+    const rnd::Random sampler(3u, 7u);
+
+    // Prepare to count draws of each value
+    std::vector<size_t> counts(8u, 0u);
+
+    // Draw many times
+    for (size_t i = 0u; i < 50000u; ++i) ++counts[sampler(rng)];
+
+    // Check that only values in range come out, equally often
+    BOOST_CHECK_EQUAL(counts[0u] + counts[1u] + counts[2u], 0u);
+    for (size_t k = 3u; k <= 7u; ++k) BOOST_CHECK_CLOSE(counts[k] / 50000.0, 0.2, 5.0);
+
+    // Single value
+    BOOST_CHECK_EQUAL(rnd::Random(4u, 4u)(rng), 4u);
+
+}
+
+// Test the Poisson sampler
+BOOST_AUTO_TEST_CASE(poissonSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Edge case
+    BOOST_CHECK_EQUAL(rnd::Poisson(0.0)(rng), 0u);
+
+    // For small and large means (on both sides of the switch of method)...
+    for (double lambda : {0.1, 1.0, 5.0, 9.9, 10.0, 30.0, 500.0}) {
+
+        // Sampler
+        const rnd::Poisson sampler(lambda);
+
+        // Check mean and variance
+        const auto [mean, var] = moments([&]() { return sampler(rng); }, 100000u);
+        BOOST_CHECK_CLOSE(mean, lambda, 3.0);
+        BOOST_CHECK_CLOSE(var, lambda, 5.0);
+
+    }
+}
+
+// Test the binomial sampler
+BOOST_AUTO_TEST_CASE(binomialSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Edge cases
+    BOOST_CHECK_EQUAL(rnd::Binomial(0u, 0.5)(rng), 0u);
+    BOOST_CHECK_EQUAL(rnd::Binomial(10u, 0.0)(rng), 0u);
+    BOOST_CHECK_EQUAL(rnd::Binomial(10u, 1.0)(rng), 10u);
+
+    // For various numbers of trials and probabilities...
+    for (size_t n : {5u, 40u, 1000u}) {
+        for (double p : {0.01, 0.3, 0.5, 0.9}) {
+
+            // Sampler
+            const rnd::Binomial sampler(n, p);
+
+            // Check mean and variance
+            const auto [mean, var] = moments([&]() { return sampler(rng); }, 100000u);
+            BOOST_CHECK_CLOSE(mean, n * p, 3.0);
+            BOOST_CHECK_CLOSE(var, n * p * (1.0 - p), 5.0);
+
+        }
+    }
+}
+
+// Test the geometric sampler
+BOOST_AUTO_TEST_CASE(geometricSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Edge case
+    BOOST_CHECK_EQUAL(rnd::Geometric(1.0)(rng), 0u);
+
+    // For various probabilities...
+    for (double p : {0.001, 0.2, 0.7}) {
+
+        // Sampler
+        const rnd::Geometric sampler(p);
+
+        // Check mean and variance
+        const auto [mean, var] = moments([&]() { return sampler(rng); }, 100000u);
+        BOOST_CHECK_CLOSE(mean, (1.0 - p) / p, 3.0);
+        BOOST_CHECK_CLOSE(var, (1.0 - p) / (p * p), 5.0);
+
+    }
+}
+
+// Test the exponential sampler
+BOOST_AUTO_TEST_CASE(exponentialSampler) {
+
+    // Random number generator
+    rnd::generator rng(42u);
+
+    // Sampler
+    const rnd::Exponential sampler(4.0);
+
+    // Check mean and variance
+    const auto [mean, var] = moments([&]() { return sampler(rng); }, 100000u);
+    BOOST_CHECK_CLOSE(mean, 0.25, 3.0);
+    BOOST_CHECK_CLOSE(var, 0.0625, 5.0);
+
+}
+
+// Test that samplers give the same draws from the same stream
+BOOST_AUTO_TEST_CASE(samplersAreReproducible) {
+
+    // Two generators seeded the same way
+    rnd::generator rng1(7u), rng2(7u);
+
+    // Check that a mix of samplers gives the same draws
+    for (size_t i = 0u; i < 1000u; ++i) {
+
+        BOOST_CHECK_EQUAL(rnd::Poisson(i % 50u)(rng1), rnd::Poisson(i % 50u)(rng2));
+        BOOST_CHECK_EQUAL(rnd::Binomial(i, 0.4)(rng1), rnd::Binomial(i, 0.4)(rng2));
+        BOOST_CHECK_EQUAL(rnd::Random(0u, i)(rng1), rnd::Random(0u, i)(rng2));
+
+    }
+}
+
+// Test that the Philox engine gives the published known answers
+BOOST_AUTO_TEST_CASE(philoxKnownAnswers) {
+
+    // Note: these are the known-answer tests of Random123 for Philox4x32-10.
+
+    // Zero counter and key
+    std::array<std::uint32_t, 4u> out = rnd::Philox::block({0u, 0u, 0u, 0u}, {0u, 0u});
+    BOOST_CHECK_EQUAL(out[0u], 0x6627e8d5u);
+    BOOST_CHECK_EQUAL(out[1u], 0xe169c58du);
+    BOOST_CHECK_EQUAL(out[2u], 0xbc57ac4cu);
+    BOOST_CHECK_EQUAL(out[3u], 0x9b00dbd8u);
+
+    // All bits set
+    out = rnd::Philox::block({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu});
+    BOOST_CHECK_EQUAL(out[0u], 0x408f276du);
+    BOOST_CHECK_EQUAL(out[1u], 0x41c83b0eu);
+    BOOST_CHECK_EQUAL(out[2u], 0xa20bc7c6u);
+    BOOST_CHECK_EQUAL(out[3u], 0x6d5451fdu);
+
+    // Digits of pi
+    out = rnd::Philox::block({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u});
+    BOOST_CHECK_EQUAL(out[0u], 0xd16cfe09u);
+    BOOST_CHECK_EQUAL(out[1u], 0x94fdccebu);
+    BOOST_CHECK_EQUAL(out[2u], 0x5001e420u);
+    BOOST_CHECK_EQUAL(out[3u], 0x24126ea1u);
+
+}
+
+// Test that a Philox stream can jump ahead
+BOOST_AUTO_TEST_CASE(philoxSkipsAhead) {
+
+    // A stream
+    rnd::Philox philox1(42u, 3u, 2u, 1u);
+
+    // Skip the first ten blocks (two numbers per block) by drawing
+    for (size_t i = 0u; i < 20u; ++i) philox1();
+
+    // The same stream
+    rnd::Philox philox2(42u, 3u, 2u, 1u);
+
+    // Jump straight there
+    philox2.seek(10u);
+
+    // Check that both give the same numbers from then on
+    for (size_t i = 0u; i < 100u; ++i) BOOST_CHECK_EQUAL(philox1(), philox2());
+
+}
+
+// Test that Philox streams with different keys differ
+BOOST_AUTO_TEST_CASE(philoxStreamsDiffer) {
+
+    // Streams differing in one component only
+    rnd::Philox a(42u, 3u, 2u, 1u), b(43u, 3u, 2u, 1u), c(42u, 4u, 2u, 1u), d(42u, 3u, 5u, 1u), e(42u, 3u, 2u, 6u);
+
+    // First draw of the reference stream
+    const std::uint64_t x = a();
+
+    // Check
+    BOOST_CHECK(b() != x);
+    BOOST_CHECK(c() != x);
+    BOOST_CHECK(d() != x);
+    BOOST_CHECK(e() != x);
+
+}
+
+// Test that the generator reproduces the Mersenne Twister by default
+BOOST_AUTO_TEST_CASE(generatorMatchesMersenneTwister) {
+
+    // Generators seeded the same way
+    rnd::generator rng(42u);
+    std::mt19937_64 twister(42u);
+
+    // Check
+    for (size_t i = 0u; i < 1000u; ++i) BOOST_CHECK_EQUAL(rng(), twister());
+
+    // Reseed
+    rng.seed(7u);
+    twister.seed(7u);
+
+    // Check again
+    for (size_t i = 0u; i < 1000u; ++i) BOOST_CHECK_EQUAL(rng(), twister());
+
+    // Same with a Philox engine
+    rnd::generator counter(rnd::Philox(1u, 2u, 3u, 4u));
+    rnd::Philox philox(1u, 2u, 3u, 4u);
+
+    // Check
+    for (size_t i = 0u; i < 1000u; ++i) BOOST_CHECK_EQUAL(counter(), philox());
+
+}
+
+// Test that the first lane of the block engine is plain xoshiro256**
+BOOST_AUTO_TEST_CASE(blockMatchesXoshiro) {
+
+    // Seed the reference state with SplitMix64
+    std::array<std::uint64_t, 4u> s;
+    std::uint64_t x = 42u;
+    for (size_t k = 0u; k < 4u; ++k) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15u);
+        z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+        z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+        s[k] = z ^ (z >> 31u);
+    }
+
+    // Block engine seeded the same way
+    rnd::Block block(42u);
+
+    // Draw two blocks
+    std::vector<std::uint64_t> draws(2u * rnd::Block::SIZE);
+    for (size_t k = 0u; k < draws.size(); ++k) draws[k] = block();
+
+    // Every LANES-th draw comes from the first lane
+    for (size_t k = 0u; k < draws.size(); k += rnd::Block::LANES) {
+
+        // Reference output
+        const std::uint64_t y = std::rotl(s[1u] * 5u, 7) * 9u;
+
+        // Reference update
+        const std::uint64_t u = s[1u] << 17u;
+        s[2u] ^= s[0u];
+        s[3u] ^= s[1u];
+        s[1u] ^= s[2u];
+        s[0u] ^= s[3u];
+        s[2u] ^= u;
+        s[3u] = std::rotl(s[3u], 45);
+
+        // Check
+        BOOST_CHECK_EQUAL(draws[k], y);
+
+    }
+
+    // Check that lanes differ
+    BOOST_CHECK(draws[0u] != draws[1u]);
+
+}
+
+// Test that copying out many numbers gives the same as drawing them one by one
+BOOST_AUTO_TEST_CASE(blockFillsInBulk) {
+
+    // Two identical block engines
+    rnd::generator rng1(rnd::Block(7u)), rng2(rnd::Block(7u));
+
+    // Draw a few numbers first so bulk draws straddle blocks
+    for (size_t k = 0u; k < 100u; ++k) BOOST_CHECK_EQUAL(rng1(), rng2());
+
+    // Copy out more than a block
+    std::vector<std::uint64_t> bulk(1000u);
+    rng1.fill(bulk.data(), bulk.size());
+
+    // Check
+    for (size_t k = 0u; k < bulk.size(); ++k) BOOST_CHECK_EQUAL(bulk[k], rng2());
+
+    // Same with the Mersenne Twister
+    rnd::generator rng3(7u), rng4(7u);
+    rng3.fill(bulk.data(), bulk.size());
+    for (size_t k = 0u; k < bulk.size(); ++k) BOOST_CHECK_EQUAL(bulk[k], rng4());
+
+}
+
+// Test the block engine gives uniform numbers
+BOOST_AUTO_TEST_CASE(blockGivesUniformNumbers) {
+
+    // Random number generator
+    rnd::generator rng(rnd::Block(42u));
+
+    // Mean and variance of uniform numbers
+    auto [mean, var] = moments([&]() { return rnd::unit(rng); }, 100000u);
+
+    // Check
+    BOOST_CHECK_CLOSE(mean, 0.5, 1.0);
+    BOOST_CHECK_CLOSE(var, 1.0 / 12.0, 2.0);
+
+}
+
+// Test that many Bernoulli trials at once are the same as one by one
+BOOST_AUTO_TEST_CASE(bernoulliMaskMatchesTrials) {
+
+    // For different probabilities...
+    for (double p : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+
+        // Sampler
+        const rnd::Bernoulli trial(p);
+
+        // Two identical streams
+        rnd::generator rng1(rnd::Block(3u)), rng2(rnd::Block(3u));
+
+        // For different numbers of trials...
+        for (size_t n : {1u, 17u, 63u, 64u}) {
+
+            // Draw at once
+            const std::uint64_t bits = trial.mask(rng1, n);
+
+            // Check each trial
+            for (size_t b = 0u; b < n; ++b) BOOST_CHECK_EQUAL((bits >> b) & 1u, trial(rng2));
+
+            // Check that no bit is set beyond the trials
+            if (n < 64u) BOOST_CHECK_EQUAL(bits >> n, 0u);
+
+        }
+
+        // Check that both streams are at the same point
+        BOOST_CHECK_EQUAL(rng1(), rng2());
+
+    }
+}
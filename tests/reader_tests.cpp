@@ -410,7 +410,7 @@ BOOST_AUTO_TEST_CASE(readerErrorInvalidValue) {
     tst::write("parameters1.txt", "hello -1\nhello -1\nhello -1");
     tst::write("parameters2.txt", "hello 0\nhello 0\nhello 0\nhello 0");
     tst::write("parameters3.txt", "hello 1.5");
-    tst::write("parameters4.txt", "hello 1001");
+    tst::write("parameters4.txt", "hello 100001");
     tst::write("parameters5.txt", "hello 0.00000000000000001");
 
     // Note: We add multiple lines with the same parameters so we can call
@@ -454,13 +454,13 @@ BOOST_AUTO_TEST_CASE(readerErrorInvalidValue) {
     r2.readline();
     tst::checkError([&]() { r2.readvalue<size_t>(n, chk::strictpos<size_t>); }, "Parameter hello must be strictly positive in line 2 of file parameters2.txt");
     r2.readline();
-    tst::checkError([&]() { r2.readvalue<size_t>(n, chk::onetothousand<size_t>); }, "Parameter hello must be between 1 and 1000 in line 3 of file parameters2.txt");
+    tst::checkError([&]() { r2.readvalue<size_t>(n, chk::onetohundredthousand<size_t>); }, "Parameter hello must be between 1 and 100000 in line 3 of file parameters2.txt");
     r2.readline();
     tst::checkError([&]() { r2.readvalue<double>(x, chk::enoughmb<double>); }, "Parameter hello must be enough MB to store a double in line 4 of file parameters2.txt");
 
     // Other parameter files
     tst::checkError([&]() { r3.readvalue<double>(x, chk::proportion<double>); }, "Parameter hello must be between 0 and 1 in line 1 of file parameters3.txt");
-    tst::checkError([&]() { r4.readvalue<size_t>(n, chk::onetothousand<size_t>); }, "Parameter hello must be between 1 and 1000 in line 1 of file parameters4.txt");
+    tst::checkError([&]() { r4.readvalue<size_t>(n, chk::onetohundredthousand<size_t>); }, "Parameter hello must be between 1 and 100000 in line 1 of file parameters4.txt");
     tst::checkError([&]() { r5.readvalue<double>(x, chk::enoughmb<double>); }, "Parameter hello must be enough MB to store a double in line 1 of file parameters5.txt");
 
     // Close the file
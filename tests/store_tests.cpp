@@ -0,0 +1,333 @@
+#define BOOST_TEST_DYNAMIC_LINK
+#define BOOST_TEST_MODULE Main
+
+// These are tests that have to do with the Store structure.
+
+#include "../src/store.hpp"
+#include <boost/test/unit_test.hpp>
+
+// Test that a store starts empty
+BOOST_AUTO_TEST_CASE(storeStartsEmpty) {
+
+    // Create a store
+    Store store(1u);
+
+    // Check that it is empty
+    BOOST_CHECK(store.empty());
+    BOOST_CHECK_EQUAL(store.size(), 0u);
+    BOOST_CHECK(store.genomes.empty());
+
+}
+
+// Test that an individual can be added to a store
+BOOST_AUTO_TEST_CASE(storePushesIndividual) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 20u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Create an individual with all alleles set
+    Individual ind(1.0, arch);
+
+    // Move it somewhere
+    ind.setDeme(2u);
+    ind.setPatch(0u);
+    ind.setNSeeds(5u);
+
+    // Create a store
+    Store store(arch.nwords);
+
+    // Add the individual
+    store.push(ind);
+
+    // Check that the attributes have been copied
+    BOOST_CHECK_EQUAL(store.size(), 1u);
+    BOOST_CHECK_EQUAL(store.tolerances[0u], ind.getTolerance());
+    BOOST_CHECK_EQUAL(store.demes[0u], 2u);
+    BOOST_CHECK_EQUAL(store.patches[0u], 0u);
+    BOOST_CHECK_EQUAL(store.nseeds[0u], 5u);
+
+    // Check that the genome has been copied
+    BOOST_CHECK_EQUAL(store.genomes.size(), 1u);
+    BOOST_CHECK_EQUAL(gen::count(store.genome(0u), store.nwords), 20u);
+
+}
+
+// Test that individuals can be cloned from one store to another
+BOOST_AUTO_TEST_CASE(storeClonesIndividual) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Create a store with two different individuals
+    Store store(arch.nwords);
+    store.push(Individual(0.0, arch));
+    store.push(Individual(1.0, arch));
+
+    // Create another store
+    Store other(arch.nwords);
+
+    // Clone the second individual twice
+    other.clone(store, 1u);
+    other.clone(store, 1u);
+
+    // Check
+    BOOST_CHECK_EQUAL(other.size(), 2u);
+    BOOST_CHECK_EQUAL(other.tolerances[1u], store.tolerances[1u]);
+    BOOST_CHECK_EQUAL(gen::count(other.genome(0u), arch.nwords), pars.nloci);
+    BOOST_CHECK_EQUAL(gen::count(other.genome(1u), arch.nwords), pars.nloci);
+
+    // Remove the last one
+    other.pop();
+
+    // Check
+    BOOST_CHECK_EQUAL(other.size(), 1u);
+    BOOST_CHECK_EQUAL(other.genomes.size(), arch.nwords);
+
+}
+
+// Test that a store can be appended to another
+BOOST_AUTO_TEST_CASE(storeAppendsStore) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Create two stores
+    Store store1(arch.nwords), store2(arch.nwords);
+
+    // Fill them
+    store1.push(Individual(0.0, arch));
+    store2.push(Individual(1.0, arch));
+    store2.push(Individual(0.0, arch));
+
+    // Append the second one to the first one
+    store1.append(store2);
+
+    // Check that the individuals come in the right order
+    BOOST_CHECK_EQUAL(store1.size(), 3u);
+    BOOST_CHECK_EQUAL(gen::count(store1.genome(0u), arch.nwords), 0u);
+    BOOST_CHECK_EQUAL(gen::count(store1.genome(1u), arch.nwords), pars.nloci);
+    BOOST_CHECK_EQUAL(gen::count(store1.genome(2u), arch.nwords), 0u);
+
+    // Clear the first store
+    store1.clear();
+
+    // Check
+    BOOST_CHECK(store1.empty());
+    BOOST_CHECK(store1.genomes.empty());
+
+}
+
+// Test that an individual can be added from its attributes
+BOOST_AUTO_TEST_CASE(storePushesAttributes) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // A scratch genome with a single allele set
+    std::array<gen::word, gen::NWORDS> genome{};
+    gen::toggle(genome.data(), 3u);
+
+    // Create a store
+    Store store(arch.nwords);
+
+    // Add an individual built in the scratch genome
+    store.push(0.5, 2u, 1u, 0u, genome.data());
+
+    // Check
+    BOOST_CHECK_EQUAL(store.size(), 1u);
+    BOOST_CHECK_EQUAL(store.tolerances[0u], 0.5);
+    BOOST_CHECK_EQUAL(store.demes[0u], 2u);
+    BOOST_CHECK_EQUAL(store.patches[0u], 1u);
+    BOOST_CHECK_EQUAL(store.nseeds[0u], 0u);
+    BOOST_CHECK_EQUAL(store.genomes.size(), arch.nwords);
+    BOOST_CHECK(gen::test(store.genome(0u), 3u));
+    BOOST_CHECK_EQUAL(gen::count(store.genome(0u), arch.nwords), 1u);
+
+}
+
+// Test that pooled stores share genomes instead of copying them
+BOOST_AUTO_TEST_CASE(storeSharesPooledGenomes) {
+
+    // Parameters
+    Parameters pars;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Pool of genomes
+    Pool pool(arch.nwords);
+
+    // Create a pooled store with a fresh individual
+    Store brood(arch.nwords, &pool);
+    brood.push(Individual(1.0, arch));
+
+    // Check that its genome is in the arena
+    BOOST_CHECK(brood.fresh(0u));
+    BOOST_CHECK_EQUAL(brood.genomes.size(), arch.nwords);
+
+    // Move it into another store
+    Store adults(arch.nwords, &pool);
+    adults.append(brood);
+    brood.clear();
+
+    // Check that its genome is now in the pool
+    BOOST_CHECK(!adults.fresh(0u));
+    BOOST_CHECK(adults.genomes.empty());
+    BOOST_CHECK_EQUAL(pool.unique(), 1u);
+    BOOST_CHECK_EQUAL(gen::count(std::as_const(adults).genome(0u), arch.nwords), pars.nloci);
+
+    // Add two offspring inheriting that genome
+    brood.inherit(0.5, 1u, 0u, 0u, adults, 0u);
+    brood.inherit(0.5, 2u, 1u, 0u, adults, 0u);
+
+    // Check that they share it
+    BOOST_CHECK_EQUAL(brood.size(), 2u);
+    BOOST_CHECK(brood.genomes.empty());
+    BOOST_CHECK_EQUAL(brood.handles[0u], adults.handles[0u]);
+    BOOST_CHECK_EQUAL(brood.demes[1u], 2u);
+
+    // Make them the next generation
+    Store next(arch.nwords, &pool);
+    next.append(brood);
+
+    // Check that the genome is referred to three times
+    BOOST_CHECK_EQUAL(pool.count(adults.handles[0u]), 3u);
+
+    // Let the parent die
+    adults.release();
+    adults.clear();
+
+    // Check that the genome is still there
+    BOOST_CHECK_EQUAL(pool.unique(), 1u);
+    BOOST_CHECK_EQUAL(gen::count(std::as_const(next).genome(1u), arch.nwords), pars.nloci);
+
+    // Let the offspring die too
+    next.release();
+
+    // Check that the genome is gone
+    BOOST_CHECK_EQUAL(pool.unique(), 0u);
+
+}
+
+// Test that genomes can be stored as lists of positions
+BOOST_AUTO_TEST_CASE(storeKeepsSparseGenomes) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 1000u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // A few individuals with few alleles 1
+    std::vector<Individual> individuals;
+    for (size_t i = 0u; i < 10u; ++i) individuals.push_back(Individual(0.01, arch));
+
+    // Store them as words, and as lists
+    Store dense(arch.nwords), sparse(arch.nwords);
+    sparse.pack(true);
+    for (auto &ind : individuals) { dense.push(ind); sparse.push(ind); }
+
+    // Check
+    BOOST_CHECK(sparse.sparse);
+    BOOST_CHECK(sparse.genomes.empty());
+    BOOST_CHECK(sparse.memory() < dense.memory());
+
+    // Check that genomes read back the same
+    std::array<gen::word, gen::NWORDS> scratch;
+    for (size_t i = 0u; i < 10u; ++i) {
+        BOOST_CHECK(std::equal(dense.genome(i), dense.genome(i) + arch.nwords, sparse.read(i, scratch.data())));
+        BOOST_CHECK_EQUAL(sparse.ones(i), dense.ones(i));
+    }
+
+    // Convert both ways
+    Store packed(arch.nwords), unpacked(arch.nwords);
+    packed.pack(true);
+    packed.append(dense);
+    packed.append(sparse);
+    unpacked.append(sparse);
+    unpacked.clone(sparse, 3u);
+
+    // Check
+    BOOST_CHECK_EQUAL(packed.size(), 20u);
+    BOOST_CHECK_EQUAL(unpacked.size(), 11u);
+    for (size_t i = 0u; i < 10u; ++i) {
+        BOOST_CHECK(std::equal(dense.genome(i), dense.genome(i) + arch.nwords, packed.read(i + 10u, scratch.data())));
+        BOOST_CHECK(std::equal(dense.genome(i), dense.genome(i) + arch.nwords, unpacked.genome(i)));
+    }
+    BOOST_CHECK(std::equal(dense.genome(3u), dense.genome(3u) + arch.nwords, unpacked.genome(10u)));
+
+    // Remove the last one
+    packed.pop();
+
+    // Check that the others are untouched
+    BOOST_CHECK_EQUAL(packed.size(), 19u);
+    packed.load(18u, scratch.data());
+    BOOST_CHECK(std::equal(dense.genome(8u), dense.genome(8u) + arch.nwords, scratch.data()));
+
+    // Go back to words once empty
+    packed.clear();
+    packed.pack(false);
+    packed.push(individuals[0u]);
+
+    // Check
+    BOOST_CHECK(!packed.sparse);
+    BOOST_CHECK(std::equal(dense.genome(0u), dense.genome(0u) + arch.nwords, packed.genome(0u)));
+
+}
+
+// Test that the memory taken by genomes drops when switching to lists
+BOOST_AUTO_TEST_CASE(storeGivesBackMemoryWhenPacked) {
+
+    // Parameters
+    Parameters pars;
+
+    // Tweak
+    pars.nloci = 1000u;
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Many individuals with few alleles 1, stored as words
+    Store store(arch.nwords);
+    for (size_t i = 0u; i < 1000u; ++i) store.push(Individual(0.01, arch));
+
+    // Memory taken
+    const size_t before = store.memory();
+
+    // The population shrinks and switches to lists
+    store.clear();
+    store.pack(true);
+    for (size_t i = 0u; i < 10u; ++i) store.push(Individual(0.01, arch));
+
+    // Check that the genome arena was given back
+    BOOST_CHECK_EQUAL(store.genomes.capacity(), 0u);
+    BOOST_CHECK(store.memory() * 100u < before);
+
+    // Switch back to words
+    store.clear();
+    store.pack(false);
+    store.push(Individual(0.01, arch));
+
+    // Check that the lists were given back
+    BOOST_CHECK_EQUAL(store.positions.capacity(), 0u);
+    BOOST_CHECK_EQUAL(store.starts.capacity(), 0u);
+
+}
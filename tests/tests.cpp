@@ -138,6 +138,90 @@ BOOST_AUTO_TEST_CASE(useCaseWithParameterSaving) {
 
 }
 
+// Test that the mutation sampler picked at startup is saved
+BOOST_AUTO_TEST_CASE(useCaseWithSamplerTuning) {
+
+    // Write a parameter file asking to pick the fastest sampler
+    tst::write("parameters.txt", "sampler 0\nsavepars 1");
+
+    // Run a simulation
+    doMain({"program", "parameters.txt"});
+
+    // Read the saved parameters
+    Parameters pars("paramlog.txt");
+
+    // Check that the sampler picked was recorded
+    BOOST_CHECK(pars.sampler != 0u);
+
+    // Check that the timings were recorded too
+    BOOST_CHECK(tst::readtext("paramlog.txt").find("# sampler 4 (bernoulli) takes") != std::string::npos);
+
+    // Cleanup
+    std::remove("parameters.txt");
+    std::remove("paramlog.txt");
+
+}
+
+// Test that the mutation sampler picked at startup is reported even if not saved
+BOOST_AUTO_TEST_CASE(useCaseWithSamplerTuningReported) {
+
+    // Write a parameter file asking to pick the fastest sampler (without saving)
+    tst::write("parameters.txt", "sampler 0\nsavepars 0\ntend 1");
+
+    // Capture output
+    const std::string output = tst::captureOutput([&] { doMain({"program", "parameters.txt"}); });
+
+    // Check that the sampler picked was reported
+    BOOST_CHECK(output.find("picked at startup") != std::string::npos);
+    BOOST_CHECK(output.find("Mutation sampler 0") == std::string::npos);
+
+    // Check that the timings were reported too
+    BOOST_CHECK(output.find("# sampler 4 (bernoulli) takes") != std::string::npos);
+
+    // Cleanup
+    std::remove("parameters.txt");
+
+}
+
+// Test that classes of identical plants are saved as individuals
+BOOST_AUTO_TEST_CASE(useCaseWithCohorts) {
+
+    // Write a parameter file asking for cohorts
+    tst::write("parameters.txt", "cohorts 1\nallfreq 0\ntend 10\ntsave 1\nsavedat 1");
+
+    // Run the simulation
+    doMain({"program", "parameters.txt"});
+
+    // Read the saved population sizes
+    const std::vector<double> popsizes = tst::read("popsize.dat");
+
+    // Prepare to sum
+    size_t n = 0u;
+
+    // Check
+    BOOST_CHECK_EQUAL(popsizes.size(), 11u);
+
+    // Sum over generations
+    for (auto popsize : popsizes) n += static_cast<size_t>(popsize);
+
+    // Check that every plant of every class was saved
+    BOOST_CHECK_EQUAL(tst::read("individuals.dat").size(), 3u * n);
+
+    // Check that there are fewer genomes than plants
+    BOOST_CHECK(tst::read("genomes.dat").back() < popsizes.back());
+
+    // Cleanup
+    std::remove("parameters.txt");
+    std::remove("time.dat");
+    std::remove("popsize.dat");
+    std::remove("patchsizes.dat");
+    std::remove("traitmeans.dat");
+    std::remove("individuals.dat");
+    std::remove("genomes.dat");
+    std::remove("genomebytes.dat");
+
+}
+
 // Test that it works when the user can choose which data to save
 BOOST_AUTO_TEST_CASE(useCaseUserDefinedOutput) {
 
@@ -206,12 +290,16 @@ BOOST_AUTO_TEST_CASE(useCaseAllOutputsIfNoChoice) {
     BOOST_CHECK_NO_THROW(tst::read("patchsizes.dat"));
     BOOST_CHECK_NO_THROW(tst::read("traitmeans.dat"));
     BOOST_CHECK_NO_THROW(tst::read("individuals.dat"));
+    BOOST_CHECK_NO_THROW(tst::read("genomes.dat"));
+    BOOST_CHECK_NO_THROW(tst::read("genomebytes.dat"));
 
     // Check some values
     BOOST_CHECK_EQUAL(tst::read("time.dat").size(), 11u);
     BOOST_CHECK_EQUAL(tst::read("popsize.dat").size(), 11u);
     BOOST_CHECK_EQUAL(tst::read("patchsizes.dat").size(), 44u);
     BOOST_CHECK_EQUAL(tst::read("traitmeans.dat").size(), 44u);
+    BOOST_CHECK_EQUAL(tst::read("genomes.dat").size(), 11u);
+    BOOST_CHECK_EQUAL(tst::read("genomebytes.dat").size(), 11u);
 
     // Read the saved population sizes
     const std::vector<double> popsizes = tst::read("popsize.dat");
@@ -235,6 +323,8 @@ BOOST_AUTO_TEST_CASE(useCaseAllOutputsIfNoChoice) {
     std::remove("patchsizes.dat");
     std::remove("traitmeans.dat");
     std::remove("individuals.dat");
+    std::remove("genomes.dat");
+    std::remove("genomebytes.dat");
 
 }
 
@@ -253,6 +343,8 @@ BOOST_AUTO_TEST_CASE(useCaseNothingIsSaved) {
     tst::checkError([&] {tst::read("patchsizes.dat");}, "Unable to open file patchsizes.dat");
     tst::checkError([&] {tst::read("traitmeans.dat");}, "Unable to open file traitmeans.dat");
     tst::checkError([&] {tst::read("individuals.dat");}, "Unable to open file individuals.dat");
+    tst::checkError([&] {tst::read("genomes.dat");}, "Unable to open file genomes.dat");
+    tst::checkError([&] {tst::read("genomebytes.dat");}, "Unable to open file genomebytes.dat");
 
     // Cleanup
     std::remove("parameters.txt");
@@ -163,4 +163,121 @@ void tst::checkOutput(const std::function<void()>& func, const std::string& expe
     // Is it as expected?
     BOOST_CHECK_EQUAL(output, expected);
 
-}
\ No newline at end of file
+}
+
+// Function to run a population and record its final state
+std::vector<double> tst::runAndRecord(
+    const Parameters &pars, const size_t &ngens,
+    const std::function<void(Architecture&)> &tweak,
+    const std::function<void(const Population&)> &inspect
+) {
+
+    // pars: parameter set
+    // ngens: number of generations to run (unless extinct before)
+    // tweak: what to change in the architecture before starting (if anything)
+    // inspect: what to check on the population at the end (if anything)
+
+    // Seed the global random number generator from the parameters
+    rnd::rng.seed(pars.seed);
+
+    // Architecture
+    Architecture arch(pars);
+
+    // Change it if needed
+    if (tweak) tweak(arch);
+
+    // Create a population
+    Population pop(pars, arch);
+
+    // Dummy printer
+    Printer print({"foo", "bar"});
+
+    // Run a few generations
+    for (size_t t = 0u; t < ngens && !pop.extinct(); ++t) {
+
+        pop.cycle(print);
+        pop.moveon();
+
+    }
+
+    // Check the population if needed
+    if (inspect) inspect(pop);
+
+    // Prepare to record the final state
+    std::vector<double> outcome;
+
+    // Record the location and trait value of every individual
+    for (size_t i = 0u; i < pop.size(); ++i) {
+
+        outcome.push_back(pop.getDeme(i));
+        outcome.push_back(pop.getPatch(i));
+        outcome.push_back(pop.getTolerance(i));
+
+    }
+
+    // Exit
+    return outcome;
+
+}
+
+// Function to average the outcome of one generation over replicates
+std::array<double, 3u> tst::runAndAverage(const Parameters &pars, const size_t &nreps) {
+
+    // pars: parameter set
+    // nreps: number of replicates
+
+    // Note: replicate r seeds the global random number generator with r.
+    // Returns the mean population size, and the mean trait value and patch
+    // of the newborns.
+
+    // Dummy printer
+    Printer print({"foo", "bar"});
+
+    // Prepare to sum outcomes over replicates
+    double n = 0.0, x = 0.0, g = 0.0;
+
+    // For each replicate...
+    for (size_t r = 0u; r < nreps; ++r) {
+
+        // Seed the global random number generator
+        rnd::rng.seed(r);
+
+        // Architecture
+        Architecture arch(pars);
+
+        // Create a population
+        Population pop(pars, arch);
+
+        // Run one generation
+        pop.cycle(print);
+        pop.moveon();
+
+        // Record the population size
+        n += pop.size();
+
+        // And the trait values and patches of the newborns
+        for (size_t i = 0u; i < pop.size(); ++i) {
+
+            x += pop.getTolerance(i);
+            g += pop.getPatch(i);
+
+        }
+    }
+
+    // Exit
+    return { n / nreps, x / n, g / n };
+
+}
+
+// Function to check that two outcomes agree value by value
+void tst::checkClose(const std::vector<double> &x, const std::vector<double> &y, const double &tol) {
+
+    // x, y: outcomes to compare
+    // tol: tolerance (in percent)
+
+    // Check
+    BOOST_CHECK_EQUAL(y.size(), x.size());
+    for (size_t i = 0u; i < x.size() && i < y.size(); ++i)
+        BOOST_CHECK_CLOSE(y[i], x[i], tol);
+
+}
@@ -3,11 +3,14 @@
 
 // This header is for the tst (test) namespace, which contains functions used in unit tests.
 
+#include "../src/population.hpp"
+
 #include <vector>
 #include <string>
 #include <functional>
 #include <fstream>
 #include <sstream>
+#include <array>
 #include <boost/test/unit_test.hpp>
 
 namespace tst
@@ -21,6 +24,15 @@ namespace tst
     void checkOutput(const std::function<void()>&, const std::string&);
     std::string captureOutput(const std::function<void()>&);
 
+    // Functions to run populations and record what they end up with
+    std::vector<double> runAndRecord(
+        const Parameters&, const size_t& = 5u,
+        const std::function<void(Architecture&)>& = nullptr,
+        const std::function<void(const Population&)>& = nullptr
+    );
+    std::array<double, 3u> runAndAverage(const Parameters&, const size_t& = 20u);
+    void checkClose(const std::vector<double>&, const std::vector<double>&, const double&);
+
 }
 
 #endif
\ No newline at end of file
@@ -93,3 +93,26 @@ BOOST_AUTO_TEST_CASE(undefinedPower) {
 
 }
 
+
+// Test that room is made in a vector with some to spare
+BOOST_AUTO_TEST_CASE(reserveWithRoomToSpare) {
+
+    // Empty vector
+    std::vector<double> v;
+
+    // Make room
+    utl::reserve(v, 100u);
+
+    // Check that there is some to spare
+    BOOST_CHECK(v.capacity() >= 150u);
+
+    // Remember where the elements are
+    const double *data = v.data();
+
+    // Ask for a little more
+    utl::reserve(v, 120u);
+
+    // Check that the vector was not reallocated
+    BOOST_CHECK(v.data() == data);
+
+}